@@ -0,0 +1,77 @@
+# Copyright (c) 2012-2022 Esri R&D Center Zurich
+
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+
+#   https://www.apache.org/licenses/LICENSE-2.0
+
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# A copy of the license is available in the repository's LICENSE file.
+
+# Compares the generation throughput with all auxiliary encoders (reports, prints, errors and attribute evaluation)
+# against geometry-only runs, e.g.: python benchmarks/encoder_pipeline_benchmark.py --shapes 20000 --threads 0
+
+import argparse
+import os
+import time
+
+import pyprt
+
+REPO_PATH = os.path.dirname(os.path.dirname(os.path.realpath(__file__)))
+ENCODER = 'com.esri.pyprt.PyEncoder'
+
+CONFIGURATIONS = [
+    ('all auxiliary encoders', {}),
+    ('no attributes', {'emitAttributes': False}),
+    ('no prints, no errors', {'emitPrints': False, 'emitErrors': False}),
+    ('geometry only', {'emitReport': False, 'emitAttributes': False, 'emitPrints': False, 'emitErrors': False}),
+]
+
+
+def create_shapes(count):
+    shapes = []
+    for i in range(count):
+        x = (i % 100) * 20.0
+        z = (i // 100) * 20.0
+        shapes.append(pyprt.InitialShape([x, 0, z, x, 0, z + 10, x + 10, 0, z + 10, x + 10, 0, z]))
+    return shapes
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Auxiliary encoder pipeline benchmark')
+    parser.add_argument('--shapes', type=int, default=5000, help='number of initial shapes')
+    parser.add_argument('--repeats', type=int, default=3, help='timed runs per configuration, the best one counts')
+    parser.add_argument('--threads', type=int, default=1, help='generation threads, 0 uses all cores')
+    parser.add_argument('--rpk', default=os.path.join(REPO_PATH, 'tests', 'data', 'candler.rpk'))
+    args = parser.parse_args()
+
+    pyprt.initialize_prt()
+    model_generator = pyprt.ModelGenerator(create_shapes(args.shapes))
+    shape_attributes = [{}]
+
+    # warm up the rule package and the PRT cache
+    model_generator.generate_model(shape_attributes, args.rpk, ENCODER, {}, args.threads)
+
+    baseline = None
+    for name, options in CONFIGURATIONS:
+        best = float('inf')
+        for _ in range(args.repeats):
+            start = time.perf_counter()
+            models = model_generator.generate_model(shape_attributes, args.rpk, ENCODER, options, args.threads)
+            best = min(best, time.perf_counter() - start)
+        assert len(models) == args.shapes
+
+        throughput = args.shapes / best
+        baseline = baseline or throughput
+        print('{:<24} {:>10.0f} shapes/s  ({:.2f}x)'.format(name, throughput, throughput / baseline))
+
+    pyprt.shutdown_prt()
+
+
+if __name__ == '__main__':
+    main()
@@ -25,90 +25,42 @@ except ModuleNotFoundError:
     sys.exit("This module can be imported only if arcgis package is installed.")
 
 
-def add_dimension(array_coord_2d):
-    array_coord_3d = np.insert(array_coord_2d, 1, 0, axis=1)
-    return np.reshape(array_coord_3d, (1, array_coord_3d.shape[0] * array_coord_3d.shape[1]))
-
-
-def swap_yz_dimensions(array_coord):
-    coord_swap_dim = array_coord.copy()
-    temp = np.copy(array_coord[:, 1])
-    coord_swap_dim[:, 1] = coord_swap_dim[:, 2]
-    coord_swap_dim[:, 2] = temp
-    return np.reshape(coord_swap_dim, (1, coord_swap_dim.shape[0] * coord_swap_dim.shape[1]))
-
-
-def get_hole_info(geo):
-    # use Shapely to detect interior rings (holes)
-    # doing the ccw check is a workaround as sometimes the exterior is actually a hole
-    # we assume that interior rings follow "their" exterior ring
-
-    shapely_geo = geo.as_shapely
-
-    shapely_rings = []
-    for shapely_part in shapely_geo.geoms:
-        shapely_rings.append(shapely_part.exterior)
-        for shapely_interior in shapely_part.interiors:
-            shapely_rings.append(shapely_interior)
-
-    holes = []
-    hole = []
-    shapely_face_index = 0
-    for shapely_ring in shapely_rings:
-        if not shapely_ring.is_ccw:  # exterior
-            if len(hole) > 0:
-                holes.append(hole)
-            hole = [shapely_face_index]
-        else:  # interior
-            hole.append(shapely_face_index)
-        shapely_face_index += 1
-    if len(hole) > 0:
-        holes.append(hole)
-
-    return holes
-
-
 def arcgis_to_pyprt(feature_set):
-    """arcgis_to_pyprt(feature_set) -> List[InitialShape]
-    This function allows converting an ArcGIS FeatureSet into a list of PyPRT InitialShape instances.
+    """arcgis_to_pyprt(feature_set) -> InitialShapeBatch
+    This function allows converting an ArcGIS FeatureSet into a PyPRT InitialShapeBatch.
     You then typically call the ModelGenerator constructor with the return value if this function as parameter.
+    The rings are collected as flat arrays, the axis conversion and the detection of holes are done natively by
+    InitialShapeBatch.from_rings.
     Parameters:
         feature_set: FeatureSet
     Returns:
-        List[InitialShape]
+        InitialShapeBatch -- changed in v1.7.0, this function returned a List[InitialShape] before. The batch
+        supports len() and slicing, which returns an InitialShapeBatch again, but it cannot be indexed or iterated
+        to get single InitialShapes. The ModelGenerator constructor accepts it like a list.
     """
-    initial_geometries = []
+    rings = []
+    ring_offsets = [0]
+    shape_offsets = [0]
     for feature in feature_set.features:
         try:
             geo = Geometry(feature.geometry)
             if geo.type == 'Polygon' and (not geo.is_empty):
-                pts_cnt = 0
-                vert_coord_list = []
-                face_count_list = []
-                coord_list = geo.coordinates()
-
-                for face_idx, coord_part in enumerate(coord_list):
-                    coord_remove_last = coord_part[:-1]
-                    coord_inverse = np.flip(coord_remove_last, axis=0)
-                    coord_inverse[:, 1] *= -1
-
-                    if len(coord_part[0]) == 2:
-                        coord_fin = add_dimension(coord_inverse)
-                    elif len(coord_part[0]) == 3:
-                        coord_fin = swap_yz_dimensions(coord_inverse)
-                    else:
-                        raise "Only 2D or 3D points are supported."
-
-                    vert_coord_list.extend(coord_fin[0])
-                    nb_pts = len(coord_fin[0]) / 3
-                    pts_cnt += nb_pts
-                    face_count_list.append(int(nb_pts))
-
-                face_indices_list = list(range(0, sum(face_count_list)))
-                holes = get_hole_info(geo)
-
-                initial_geometry = pyprt.InitialShape(vert_coord_list, face_indices_list, face_count_list, holes)
-                initial_geometries.append(initial_geometry)
+                feature_rings = []
+                for coord_part in geo.coordinates():
+                    ring = np.asarray(coord_part, dtype=np.float64)
+                    if ring.ndim != 2 or ring.shape[1] not in (2, 3):
+                        raise ValueError("Only 2D or 3D points are supported.")
+                    if ring.shape[1] == 2:
+                        ring = np.column_stack((ring, np.zeros(len(ring))))
+                    feature_rings.append(ring)
+
+                for ring in feature_rings:
+                    rings.append(ring)
+                    ring_offsets.append(ring_offsets[-1] + len(ring))
+                shape_offsets.append(shape_offsets[-1] + len(feature_rings))
         except:
             print(f'Ignoring invalid feature with id = {feature.get_value("objectid")}.')
-    return initial_geometries
+
+    coordinates = np.concatenate(rings).ravel() if rings else np.empty(0, dtype=np.float64)
+    return pyprt.InitialShapeBatch.from_rings(coordinates, np.array(ring_offsets, dtype=np.uint64),
+                                              np.array(shape_offsets, dtype=np.uint64), 3)
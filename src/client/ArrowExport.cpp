@@ -0,0 +1,283 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#include "ArrowExport.h"
+#include "ArrowCDataInterface.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace py = pybind11;
+
+namespace {
+
+constexpr const char* ARROW_STREAM_CAPSULE_NAME = "arrow_array_stream";
+
+// Arrow requires non-null data buffers, empty payload vectors may not have allocated any memory
+alignas(64) const uint8_t EMPTY_BUFFER[64] = {};
+
+const void* toBuffer(const void* data) {
+	return (data != nullptr) ? data : EMPTY_BUFFER;
+}
+
+// record batches of many models keep the per batch overhead of consumers low, the offsets limit the batch size
+constexpr size_t MAX_BATCH_ROWS = 64 * 1024;
+constexpr size_t MAX_OFFSET = static_cast<size_t>(std::numeric_limits<int32_t>::max());
+
+// the geometry of consecutive models, concatenated into the buffers of one record batch
+struct BatchData {
+	std::vector<uint64_t> mInitialShapeIndices;
+	std::vector<int32_t> mVertexOffsets{0};
+	std::vector<int32_t> mIndexOffsets{0};
+	std::vector<int32_t> mFaceOffsets{0};
+	Coordinates mVertices;
+	Indices mIndices;
+	Indices mFaces;
+};
+
+using BatchDataPtr = std::shared_ptr<const BatchData>;
+
+/**
+ * Copies the geometry of the models starting at next into one batch, at most MAX_BATCH_ROWS models and as many as fit
+ * into 32 bit offsets. Advances next past the copied models.
+ */
+BatchDataPtr createBatch(const std::vector<GeneratedModel>& models, size_t& next) {
+	size_t vertexCount = 0;
+	size_t indexCount = 0;
+	size_t faceCount = 0;
+	size_t end = next;
+	for (; end < models.size() && end - next < MAX_BATCH_ROWS; end++) {
+		const GeneratedPayload& payload = *models[end].getPayload();
+		const size_t nextVertexCount = vertexCount + payload.mVertices.size() / 3;
+		const size_t nextIndexCount = indexCount + payload.mIndices.size();
+		const size_t nextFaceCount = faceCount + payload.mFaces.size();
+		if (nextVertexCount > MAX_OFFSET || nextIndexCount > MAX_OFFSET || nextFaceCount > MAX_OFFSET) {
+			if (end == next)
+				throw std::overflow_error("generated model is too large for the Arrow export.");
+			break;
+		}
+		vertexCount = nextVertexCount;
+		indexCount = nextIndexCount;
+		faceCount = nextFaceCount;
+	}
+
+	auto batch = std::make_shared<BatchData>();
+	batch->mInitialShapeIndices.reserve(end - next);
+	batch->mVertexOffsets.reserve(end - next + 1);
+	batch->mIndexOffsets.reserve(end - next + 1);
+	batch->mFaceOffsets.reserve(end - next + 1);
+	batch->mVertices.reserve(vertexCount * 3);
+	batch->mIndices.reserve(indexCount);
+	batch->mFaces.reserve(faceCount);
+	for (size_t m = next; m < end; m++) {
+		const GeneratedModel& model = models[m];
+		const GeneratedPayload& payload = *model.getPayload();
+		batch->mInitialShapeIndices.push_back(model.getInitialShapeIndex());
+		batch->mVertices.insert(batch->mVertices.end(), payload.mVertices.begin(), payload.mVertices.end());
+		batch->mIndices.insert(batch->mIndices.end(), payload.mIndices.begin(), payload.mIndices.end());
+		batch->mFaces.insert(batch->mFaces.end(), payload.mFaces.begin(), payload.mFaces.end());
+		batch->mVertexOffsets.push_back(static_cast<int32_t>(batch->mVertices.size() / 3));
+		batch->mIndexOffsets.push_back(static_cast<int32_t>(batch->mIndices.size()));
+		batch->mFaceOffsets.push_back(static_cast<int32_t>(batch->mFaces.size()));
+	}
+	next = end;
+	return batch;
+}
+
+// every exported array owns its buffer and child pointers, so consumers can move children out independently
+struct ArrayNode {
+	BatchDataPtr mData;
+	std::vector<const void*> mBuffers;
+	std::vector<ArrowArray> mChildren;
+	std::vector<ArrowArray*> mChildPointers;
+};
+
+void releaseArray(ArrowArray* array) {
+	auto* node = static_cast<ArrayNode*>(array->private_data);
+	for (ArrowArray* child : node->mChildPointers) {
+		if (child->release != nullptr)
+			child->release(child);
+	}
+	delete node;
+	array->release = nullptr;
+}
+
+ArrayNode* initArray(ArrowArray& array, const BatchDataPtr& data, size_t length,
+                     std::initializer_list<const void*> buffers, size_t childCount) {
+	auto* node = new ArrayNode{data, buffers, std::vector<ArrowArray>(childCount), {}};
+	for (ArrowArray& child : node->mChildren)
+		node->mChildPointers.push_back(&child);
+
+	array.length = static_cast<int64_t>(length);
+	array.null_count = 0;
+	array.offset = 0;
+	array.n_buffers = static_cast<int64_t>(node->mBuffers.size());
+	array.n_children = static_cast<int64_t>(childCount);
+	array.buffers = node->mBuffers.data();
+	array.children = node->mChildPointers.data();
+	array.dictionary = nullptr;
+	array.release = &releaseArray;
+	array.private_data = node;
+	return node;
+}
+
+void exportBatch(const BatchDataPtr& data, ArrowArray& out) {
+	const size_t rowCount = data->mInitialShapeIndices.size();
+	const size_t vertexCount = data->mVertices.size() / 3;
+
+	ArrayNode* root = initArray(out, data, rowCount, {nullptr}, 4);
+	initArray(root->mChildren[0], data, rowCount, {nullptr, toBuffer(data->mInitialShapeIndices.data())}, 0);
+
+	ArrayNode* vertices = initArray(root->mChildren[1], data, rowCount, {nullptr, data->mVertexOffsets.data()}, 1);
+	ArrayNode* points = initArray(vertices->mChildren[0], data, vertexCount, {nullptr}, 1);
+	initArray(points->mChildren[0], data, vertexCount * 3, {nullptr, toBuffer(data->mVertices.data())}, 0);
+
+	ArrayNode* indices = initArray(root->mChildren[2], data, rowCount, {nullptr, data->mIndexOffsets.data()}, 1);
+	initArray(indices->mChildren[0], data, data->mIndices.size(), {nullptr, toBuffer(data->mIndices.data())}, 0);
+
+	ArrayNode* faces = initArray(root->mChildren[3], data, rowCount, {nullptr, data->mFaceOffsets.data()}, 1);
+	initArray(faces->mChildren[0], data, data->mFaces.size(), {nullptr, toBuffer(data->mFaces.data())}, 0);
+}
+
+struct SchemaNode {
+	std::string mFormat;
+	std::string mName;
+	std::vector<ArrowSchema> mChildren;
+	std::vector<ArrowSchema*> mChildPointers;
+};
+
+void releaseSchema(ArrowSchema* schema) {
+	auto* node = static_cast<SchemaNode*>(schema->private_data);
+	for (ArrowSchema* child : node->mChildPointers) {
+		if (child->release != nullptr)
+			child->release(child);
+	}
+	delete node;
+	schema->release = nullptr;
+}
+
+SchemaNode* initSchema(ArrowSchema& schema, const char* format, const char* name, size_t childCount) {
+	auto* node = new SchemaNode{format, name, std::vector<ArrowSchema>(childCount), {}};
+	for (ArrowSchema& child : node->mChildren)
+		node->mChildPointers.push_back(&child);
+
+	schema.format = node->mFormat.c_str();
+	schema.name = node->mName.c_str();
+	schema.metadata = nullptr;
+	schema.flags = 0;
+	schema.n_children = static_cast<int64_t>(childCount);
+	schema.children = node->mChildPointers.data();
+	schema.dictionary = nullptr;
+	schema.release = &releaseSchema;
+	schema.private_data = node;
+	return node;
+}
+
+void exportSchema(ArrowSchema& out) {
+	SchemaNode* root = initSchema(out, "+s", "", 4);
+	initSchema(root->mChildren[0], "L", "initial_shape_index", 0);
+
+	SchemaNode* vertices = initSchema(root->mChildren[1], "+l", "vertices", 1);
+	SchemaNode* points = initSchema(vertices->mChildren[0], "+w:3", "item", 1);
+	initSchema(points->mChildren[0], "g", "item", 0);
+
+	SchemaNode* indices = initSchema(root->mChildren[2], "+l", "indices", 1);
+	initSchema(indices->mChildren[0], "I", "item", 0);
+
+	SchemaNode* faces = initSchema(root->mChildren[3], "+l", "face_counts", 1);
+	initSchema(faces->mChildren[0], "I", "item", 0);
+}
+
+struct StreamState {
+	std::vector<GeneratedModel> mModels;
+	size_t mNext = 0;
+	std::string mLastError;
+};
+
+int getStreamSchema(ArrowArrayStream* stream, ArrowSchema* out) {
+	auto* state = static_cast<StreamState*>(stream->private_data);
+	try {
+		exportSchema(*out);
+		return 0;
+	}
+	catch (const std::exception& e) {
+		state->mLastError = e.what();
+		return ENOMEM;
+	}
+}
+
+int getStreamNext(ArrowArrayStream* stream, ArrowArray* out) {
+	auto* state = static_cast<StreamState*>(stream->private_data);
+	if (state->mNext == state->mModels.size()) {
+		out->release = nullptr; // end of stream
+		return 0;
+	}
+
+	try {
+		exportBatch(createBatch(state->mModels, state->mNext), *out);
+		return 0;
+	}
+	catch (const std::overflow_error& e) {
+		state->mLastError = e.what();
+		return EOVERFLOW;
+	}
+	catch (const std::exception& e) {
+		state->mLastError = e.what();
+		return ENOMEM;
+	}
+}
+
+const char* getStreamLastError(ArrowArrayStream* stream) {
+	auto* state = static_cast<StreamState*>(stream->private_data);
+	return state->mLastError.empty() ? nullptr : state->mLastError.c_str();
+}
+
+void releaseStream(ArrowArrayStream* stream) {
+	auto* state = static_cast<StreamState*>(stream->private_data);
+	if (Py_IsInitialized()) {
+		py::gil_scoped_acquire acquire;
+		delete state;
+	}
+	stream->release = nullptr;
+}
+
+} // namespace
+
+py::capsule exportArrowStream(const std::vector<GeneratedModel>& models) {
+	auto* stream = new ArrowArrayStream();
+	stream->get_schema = &getStreamSchema;
+	stream->get_next = &getStreamNext;
+	stream->get_last_error = &getStreamLastError;
+	stream->release = &releaseStream;
+	stream->private_data = new StreamState{models};
+
+	// consumers move the stream out of the capsule, only an unconsumed stream is still released here
+	return py::capsule(stream, ARROW_STREAM_CAPSULE_NAME, [](PyObject* capsule) {
+		auto* stream = static_cast<ArrowArrayStream*>(PyCapsule_GetPointer(capsule, ARROW_STREAM_CAPSULE_NAME));
+		if (stream->release != nullptr)
+			stream->release(stream);
+		delete stream;
+	});
+}
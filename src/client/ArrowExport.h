@@ -0,0 +1,33 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#pragma once
+
+#include "GeneratedModel.h"
+
+#include "pybind11/pybind11.h"
+
+#include <vector>
+
+/**
+ * Exports the geometry of the generated models as an Arrow C stream ("arrow_array_stream" capsule). Every model becomes
+ * one row: the initial shape index, the vertices as a list of 3D points, the vertex indices and the face vertex counts.
+ * Consecutive models are copied into record batches of up to 65536 rows when the consumer requests them.
+ */
+pybind11::capsule exportArrowStream(const std::vector<GeneratedModel>& models);
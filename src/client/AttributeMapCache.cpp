@@ -0,0 +1,171 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#include "AttributeMapCache.h"
+#include "utils.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace py = pybind11;
+
+namespace {
+
+template <typename T>
+void appendBytes(std::string& key, const T& value) {
+	key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// returns false for values the content key cannot represent
+bool appendValue(std::string& key, const py::handle& value, bool allowList) {
+	if (py::isinstance<py::bool_>(value)) { // check for boolean first, bool is an int in Python
+		key.push_back('b');
+		key.push_back(value.ptr() == Py_True ? '1' : '0');
+	}
+	else if (py::isinstance<py::float_>(value)) {
+		key.push_back('f');
+		appendBytes(key, PyFloat_AsDouble(value.ptr()));
+	}
+	else if (py::isinstance<py::int_>(value)) {
+		int overflow = 0;
+		const long long v = PyLong_AsLongLongAndOverflow(value.ptr(), &overflow);
+		if (overflow != 0)
+			return false;
+		key.push_back('i');
+		appendBytes(key, v);
+	}
+	else if (py::isinstance<py::str>(value)) {
+		Py_ssize_t size = 0;
+		const char* utf8 = PyUnicode_AsUTF8AndSize(value.ptr(), &size);
+		if (utf8 == nullptr) {
+			PyErr_Clear();
+			return false;
+		}
+		key.push_back('s');
+		appendBytes(key, static_cast<int64_t>(size));
+		key.append(utf8, static_cast<size_t>(size));
+	}
+	else if (allowList && py::isinstance<py::list>(value)) {
+		const py::list list = py::reinterpret_borrow<py::list>(value);
+		key.push_back('l');
+		appendBytes(key, static_cast<int64_t>(list.size()));
+		for (const py::handle item : list) {
+			if (!appendValue(key, item, false))
+				return false;
+		}
+	}
+	else {
+		return false;
+	}
+	return true;
+}
+
+AttributeMapSPtr convert(const py::dict& attributes) {
+	AttributeMapBuilderPtr builder{prt::AttributeMapBuilder::create()};
+	return AttributeMapSPtr{pcu::createAttributeMapFromPythonDict(attributes, *builder).release(), PRTDestroyer()};
+}
+
+} // namespace
+
+AttributeMapCache& AttributeMapCache::get() {
+	static AttributeMapCache theCache;
+	return theCache;
+}
+
+// serializes the dict in iteration order, empty if a value is not supported
+std::string AttributeMapCache::getContentKey(const py::dict& attributes) {
+	std::string key;
+	for (const auto& item : attributes) {
+		if (!py::isinstance<py::str>(item.first) || !appendValue(key, item.first, false) ||
+		    !appendValue(key, item.second, true))
+			return {};
+	}
+	key.push_back('.'); // the empty dict gets a non-empty key too
+	return key;
+}
+
+/**
+ * Needs the GIL. The conversion of a missing entry happens outside of the lock, concurrent misses for the same content
+ * may convert it twice.
+ */
+AttributeMapSPtr AttributeMapCache::getAttributeMap(const py::dict& attributes) {
+	const std::string key = getContentKey(attributes);
+	if (key.empty())
+		return convert(attributes);
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		const auto it = mIndex.find(key);
+		if (it != mIndex.end()) {
+			mEntries.splice(mEntries.begin(), mEntries, it->second);
+			mHits++;
+			return it->second->second;
+		}
+		mMisses++;
+	}
+
+	AttributeMapSPtr attributeMap = convert(attributes);
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (mCapacity == 0 || mIndex.count(key) > 0)
+		return attributeMap;
+
+	mEntries.emplace_front(key, attributeMap);
+	mIndex.emplace(key, mEntries.begin());
+	while (mEntries.size() > mCapacity) {
+		mIndex.erase(mEntries.back().first);
+		mEntries.pop_back();
+	}
+	return attributeMap;
+}
+
+void AttributeMapCache::clear() {
+	std::lock_guard<std::mutex> lock(mMutex);
+	mIndex.clear();
+	mEntries.clear();
+}
+
+void AttributeMapCache::setCapacity(size_t capacity) {
+	std::lock_guard<std::mutex> lock(mMutex);
+	mCapacity = capacity;
+	while (mEntries.size() > mCapacity) {
+		mIndex.erase(mEntries.back().first);
+		mEntries.pop_back();
+	}
+}
+
+size_t AttributeMapCache::getCapacity() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mCapacity;
+}
+
+size_t AttributeMapCache::getHitCount() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mHits;
+}
+
+size_t AttributeMapCache::getMissCount() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mMisses;
+}
+
+size_t AttributeMapCache::getEntryCount() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mEntries.size();
+}
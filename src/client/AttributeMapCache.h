@@ -0,0 +1,66 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#pragma once
+
+#include "types.h"
+
+#include "pybind11/pybind11.h"
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * Process-wide LRU cache of the attribute maps converted from Python shape attribute dicts. Dicts are keyed by their
+ * content, so the same attributes are converted once and reused across initial shapes and generate calls. Dicts with
+ * values of other types than bool, float, int, str or lists of those are converted without caching.
+ */
+class AttributeMapCache {
+public:
+	static AttributeMapCache& get();
+
+	AttributeMapCache() = default;
+	AttributeMapCache(const AttributeMapCache&) = delete;
+	AttributeMapCache& operator=(const AttributeMapCache&) = delete;
+	~AttributeMapCache() = default;
+
+	static std::string getContentKey(const pybind11::dict& attributes);
+
+	AttributeMapSPtr getAttributeMap(const pybind11::dict& attributes);
+	void clear();
+
+	void setCapacity(size_t capacity);
+	size_t getCapacity() const;
+	size_t getHitCount() const;
+	size_t getMissCount() const;
+	size_t getEntryCount() const;
+
+private:
+	using EntryList = std::list<std::pair<std::string, AttributeMapSPtr>>;
+
+	mutable std::mutex mMutex;
+	EntryList mEntries; // most recently used first
+	std::unordered_map<std::string, EntryList::iterator> mIndex;
+	size_t mCapacity = 1024; // zero disables the cache
+	size_t mHits = 0;
+	size_t mMisses = 0;
+};
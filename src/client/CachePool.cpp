@@ -0,0 +1,150 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#include "CachePool.h"
+#include "logging.h"
+
+CachePool& CachePool::get() {
+	static CachePool thePool;
+	return thePool;
+}
+
+CacheSPtr CachePool::getCache() {
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (!mCache)
+		mCache.reset(prt::CacheObject::create(prt::CacheObject::CACHE_TYPE_DEFAULT), PRTDestroyer());
+	return mCache;
+}
+
+// for resources which PRT caches under their own URI, e.g. initial shape geometry files
+void CachePool::track(const std::wstring& uri, uintmax_t size) {
+	track(uri, std::vector<std::wstring>{uri}, size);
+}
+
+/**
+ * Records a resource resolved through the shared cache, the size is an estimate of the memory it occupies. Must be
+ * called on every use of the resource to keep the least recently used order, an already tracked resource is only
+ * moved to the front.
+ */
+void CachePool::track(const std::wstring& key, const std::vector<std::wstring>& uris, uintmax_t size) {
+	std::lock_guard<std::mutex> lock(mMutex);
+	const auto it = mTrackedIndex.find(key);
+	if (it != mTrackedIndex.end()) {
+		Tracked& tracked = *it->second;
+		mTracked.splice(mTracked.begin(), mTracked, it->second);
+		mBytes = mBytes - tracked.mSize + size;
+		tracked.mSize = size;
+		if (tracked.mURIs != uris)
+			tracked.mURIs = uris;
+	}
+	else {
+		mTracked.push_front({key, uris, size});
+		mTrackedIndex.emplace(key, mTracked.begin());
+		mBytes += size;
+	}
+	enforceBudget();
+}
+
+void CachePool::flush() {
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (mCache)
+		mCache->flushAll();
+	mTracked.clear();
+	mTrackedIndex.clear();
+	mBytes = 0;
+	mFlushes++;
+}
+
+/**
+ * Flushes a tracked resource with all its URIs. Other URIs are passed on to the PRT cache as they are, but are not
+ * counted as flushes.
+ */
+void CachePool::flushEntry(const std::wstring& uri) {
+	std::lock_guard<std::mutex> lock(mMutex);
+	const auto it = mTrackedIndex.find(uri);
+	if (it == mTrackedIndex.end()) {
+		if (mCache)
+			mCache->flushEntry(uri.c_str());
+		return;
+	}
+
+	flushTracked(*it->second);
+	mBytes -= it->second->mSize;
+	mTracked.erase(it->second);
+	mTrackedIndex.erase(it);
+	mFlushes++;
+}
+
+/**
+ * Drops the shared cache, must be called before PRT shuts down. Generators still holding it keep it alive.
+ */
+void CachePool::release() {
+	std::lock_guard<std::mutex> lock(mMutex);
+	mCache.reset();
+	mTracked.clear();
+	mTrackedIndex.clear();
+	mBytes = 0;
+}
+
+void CachePool::setBudget(uintmax_t budget) {
+	std::lock_guard<std::mutex> lock(mMutex);
+	mBudget = budget;
+	enforceBudget();
+}
+
+uintmax_t CachePool::getBudget() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mBudget;
+}
+
+uintmax_t CachePool::getByteCount() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mBytes;
+}
+
+size_t CachePool::getEntryCount() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mTracked.size();
+}
+
+size_t CachePool::getFlushCount() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mFlushes;
+}
+
+// expects mMutex to be held
+void CachePool::flushTracked(const Tracked& tracked) {
+	if (!mCache)
+		return;
+	for (const std::wstring& uri : tracked.mURIs)
+		mCache->flushEntry(uri.c_str());
+}
+
+// expects mMutex to be held, the most recently used resource is never evicted
+void CachePool::enforceBudget() {
+	while (mBudget > 0 && mBytes > mBudget && mTracked.size() > 1) {
+		const Tracked& lru = mTracked.back();
+		LOG_DBG << "evicting " << lru.mKey << " from the shared cache";
+		flushTracked(lru);
+		mBytes -= lru.mSize;
+		mTrackedIndex.erase(lru.mKey);
+		mTracked.pop_back();
+		mFlushes++;
+	}
+}
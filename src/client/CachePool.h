@@ -0,0 +1,81 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#pragma once
+
+#include "types.h"
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Process-wide PRT cache shared by all model generators and by rule package inspection. PRT does not report the
+ * memory held by a cache, therefore the pool tracks the size of the resources resolved through it (rule packages,
+ * initial shape geometry files) and evicts the least recently used ones once the memory budget is exceeded.
+ *
+ * A resource is tracked under a key (its file URI) together with the URIs PRT caches its content under, e.g. the
+ * rpk:file:...!/ URIs of the files in a rule package. Evicting or flushing a resource flushes all of these URIs.
+ */
+class CachePool {
+public:
+	static CachePool& get();
+
+	CachePool() = default;
+	CachePool(const CachePool&) = delete;
+	CachePool& operator=(const CachePool&) = delete;
+	~CachePool() = default;
+
+	CacheSPtr getCache();
+	void track(const std::wstring& uri, uintmax_t size);
+	void track(const std::wstring& key, const std::vector<std::wstring>& uris, uintmax_t size);
+
+	void flush();
+	void flushEntry(const std::wstring& uri);
+	void release();
+
+	void setBudget(uintmax_t budget);
+	uintmax_t getBudget() const;
+	uintmax_t getByteCount() const;
+	size_t getEntryCount() const;
+	size_t getFlushCount() const;
+
+private:
+	struct Tracked {
+		std::wstring mKey;
+		std::vector<std::wstring> mURIs;
+		uintmax_t mSize = 0;
+	};
+	using TrackedList = std::list<Tracked>;
+
+	void flushTracked(const Tracked& tracked);
+	void enforceBudget();
+
+	mutable std::mutex mMutex;
+	CacheSPtr mCache;
+	TrackedList mTracked; // most recently used first
+	std::unordered_map<std::wstring, TrackedList::iterator> mTrackedIndex;
+	uintmax_t mBudget = 0; // zero means unbounded
+	uintmax_t mBytes = 0;
+	size_t mFlushes = 0;
+};
@@ -0,0 +1,201 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#include "ColumnOutput.h"
+
+#include "pybind11/numpy.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+
+namespace py = pybind11;
+
+namespace {
+
+template <typename Value>
+struct Column {
+	std::wstring mKey;
+	bool mMixedTypes = false;
+	std::vector<std::pair<size_t, const Value*>> mValues; // row and value
+};
+
+const GeneratedPayload::AttributeValue& getVariant(const GeneratedPayload::Attribute& attribute) {
+	return attribute.mValue;
+}
+
+const GeneratedPayload::ReportValue& getVariant(const GeneratedPayload::ReportValue& value) {
+	return value;
+}
+
+py::object toPyObject(const GeneratedPayload::Attribute& attribute) {
+	return GeneratedPayload::toPyObject(attribute);
+}
+
+py::object toPyObject(const GeneratedPayload::ReportValue& value) {
+	return std::visit([](const auto& v) { return py::cast(v); }, value);
+}
+
+template <typename Value>
+class ColumnCollector {
+public:
+	void add(size_t row, const std::wstring& key, const Value& value) {
+		auto it = mColumnIndices.find(key);
+		if (it == mColumnIndices.end()) {
+			it = mColumnIndices.emplace(key, mColumns.size()).first;
+			mColumns.push_back({key});
+		}
+		Column<Value>& column = mColumns[it->second];
+		if (!column.mValues.empty())
+			column.mMixedTypes = column.mMixedTypes ||
+			                     (getVariant(*column.mValues.front().second).index() != getVariant(value).index());
+		column.mValues.emplace_back(row, &value);
+	}
+
+	const std::vector<Column<Value>>& getColumns() const {
+		return mColumns;
+	}
+
+private:
+	std::vector<Column<Value>> mColumns; // in the order in which the keys first appear
+	std::unordered_map<std::wstring, size_t> mColumnIndices;
+};
+
+template <typename T, typename Value>
+py::array_t<T> toScalarArray(const Column<Value>& column, size_t rowCount, T fill) {
+	py::array_t<T> data(static_cast<py::ssize_t>(rowCount));
+	T* values = data.mutable_data();
+	std::fill(values, values + rowCount, fill);
+	for (const auto& [row, value] : column.mValues)
+		values[row] = std::get<T>(getVariant(*value));
+	return data;
+}
+
+// strings, arrays and mixed types are stored as Python objects, None where missing
+template <typename Value>
+py::array toObjectArray(const Column<Value>& column, size_t rowCount) {
+	py::array data = py::module::import("numpy").attr("empty")(rowCount, py::arg("dtype") = "O");
+	auto** values = static_cast<PyObject**>(data.mutable_data());
+	for (const auto& [row, value] : column.mValues) {
+		py::object object = toPyObject(*value);
+		Py_XDECREF(values[row]);
+		values[row] = object.release().ptr();
+	}
+	return data;
+}
+
+template <typename Value>
+py::array_t<bool> toMask(const Column<Value>& column, size_t rowCount) {
+	py::array_t<bool> mask(static_cast<py::ssize_t>(rowCount));
+	bool* masked = mask.mutable_data();
+	std::fill(masked, masked + rowCount, true);
+	for (const auto& value : column.mValues)
+		masked[value.first] = false;
+	return mask;
+}
+
+// codes into the list of distinct strings, -1 where missing
+py::tuple toDictionaryEncoded(const Column<GeneratedPayload::ReportValue>& column, size_t rowCount) {
+	py::array_t<int32_t> codes(static_cast<py::ssize_t>(rowCount));
+	int32_t* rowCodes = codes.mutable_data();
+	std::fill(rowCodes, rowCodes + rowCount, -1);
+
+	std::unordered_map<std::wstring, int32_t> categoryCodes;
+	py::list categories;
+	for (const auto& [row, value] : column.mValues) {
+		const std::wstring& category = std::get<std::wstring>(*value);
+		auto it = categoryCodes.find(category);
+		if (it == categoryCodes.end()) {
+			it = categoryCodes.emplace(category, static_cast<int32_t>(categoryCodes.size())).first;
+			categories.append(py::cast(category));
+		}
+		rowCodes[row] = it->second;
+	}
+	return py::make_tuple(codes, categories);
+}
+
+} // namespace
+
+/**
+ * Boolean and float attributes become bool and float64 arrays, strings and arrays become object arrays. The columns
+ * are in the order in which the keys first appear.
+ */
+py::dict getAttributeColumns(const std::vector<GeneratedModel>& models) {
+	ColumnCollector<GeneratedPayload::Attribute> collector;
+	for (size_t row = 0; row < models.size(); row++) {
+		for (const GeneratedPayload::Attribute& attribute : models[row].getPayload()->mAttrVal)
+			collector.add(row, attribute.mKey, attribute);
+	}
+
+	const size_t rowCount = models.size();
+	const py::object maskedArray = py::module::import("numpy.ma").attr("MaskedArray");
+
+	py::dict result;
+	for (const Column<GeneratedPayload::Attribute>& column : collector.getColumns()) {
+		const GeneratedPayload::AttributeValue& firstValue = column.mValues.front().second->mValue;
+		py::array data;
+		if (!column.mMixedTypes && std::holds_alternative<bool>(firstValue))
+			data = toScalarArray<bool>(column, rowCount, false);
+		else if (!column.mMixedTypes && std::holds_alternative<double>(firstValue))
+			data = toScalarArray<double>(column, rowCount, std::numeric_limits<double>::quiet_NaN());
+		else
+			data = toObjectArray(column, rowCount);
+
+		result[py::cast(column.mKey)] = maskedArray(data, py::arg("mask") = toMask(column, rowCount));
+	}
+	return result;
+}
+
+/**
+ * Float and boolean reports become float64 and bool masked arrays, string reports are dictionary encoded. Reports
+ * with different types for the same key fall back to masked object arrays.
+ */
+py::dict getReportColumns(const std::vector<GeneratedModel>& models) {
+	ColumnCollector<GeneratedPayload::ReportValue> collector;
+	for (size_t row = 0; row < models.size(); row++) {
+		for (const auto& report : models[row].getPayload()->mCGAReport)
+			collector.add(row, report.first, report.second);
+	}
+
+	const size_t rowCount = models.size();
+	const py::object maskedArray = py::module::import("numpy.ma").attr("MaskedArray");
+
+	py::dict result;
+	for (const Column<GeneratedPayload::ReportValue>& column : collector.getColumns()) {
+		const GeneratedPayload::ReportValue& firstValue = *column.mValues.front().second;
+		if (!column.mMixedTypes && std::holds_alternative<std::wstring>(firstValue)) {
+			result[py::cast(column.mKey)] = toDictionaryEncoded(column, rowCount);
+			continue;
+		}
+
+		py::array data;
+		if (!column.mMixedTypes && std::holds_alternative<bool>(firstValue))
+			data = toScalarArray<bool>(column, rowCount, false);
+		else if (!column.mMixedTypes && std::holds_alternative<double>(firstValue))
+			data = toScalarArray<double>(column, rowCount, std::numeric_limits<double>::quiet_NaN());
+		else
+			data = toObjectArray(column, rowCount);
+
+		result[py::cast(column.mKey)] = maskedArray(data, py::arg("mask") = toMask(column, rowCount));
+	}
+	return result;
+}
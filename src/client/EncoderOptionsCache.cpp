@@ -0,0 +1,113 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#include "EncoderOptionsCache.h"
+#include "AttributeMapCache.h"
+#include "utils.h"
+
+#include <stdexcept>
+
+namespace py = pybind11;
+
+namespace {
+
+// the options of a few encoders and output paths, more distinct options are very rare
+constexpr size_t MAX_ENTRIES = 256;
+
+} // namespace
+
+EncoderOptionsCache& EncoderOptionsCache::get() {
+	static EncoderOptionsCache theCache;
+	return theCache;
+}
+
+/**
+ * Needs the GIL. Options with values the content key cannot represent are validated without caching.
+ */
+AttributeMapSPtr EncoderOptionsCache::getValidatedOptions(const std::wstring& encoderId, const py::dict& options) {
+	const std::string contentKey = AttributeMapCache::getContentKey(options);
+	const std::string key = contentKey.empty() ? std::string() : pcu::toUTF8FromUTF16(encoderId) + '\0' + contentKey;
+
+	if (!key.empty()) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		const auto it = mIndex.find(key);
+		if (it != mIndex.end()) {
+			mEntries.splice(mEntries.begin(), mEntries, it->second);
+			mHits++;
+			return it->second->second;
+		}
+		mMisses++;
+	}
+
+	const EncoderInfoSPtr encoderInfo = getEncoderInfo(encoderId);
+	if (!encoderInfo)
+		throw std::invalid_argument("unknown encoder '" + pcu::toUTF8FromUTF16(encoderId) + "'.");
+
+	const AttributeMapBuilderPtr builder{prt::AttributeMapBuilder::create()};
+	const AttributeMapPtr unvalidatedOptions{pcu::createAttributeMapFromPythonDict(options, *builder)};
+	const prt::AttributeMap* validatedOptions = nullptr;
+	encoderInfo->createValidatedOptionsAndStates(unvalidatedOptions.get(), &validatedOptions);
+	const AttributeMapSPtr result{validatedOptions, PRTDestroyer()};
+
+	if (!key.empty()) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (mIndex.count(key) == 0) {
+			mEntries.emplace_front(key, result);
+			mIndex.emplace(key, mEntries.begin());
+			if (mEntries.size() > MAX_ENTRIES) {
+				mIndex.erase(mEntries.back().first);
+				mEntries.pop_back();
+			}
+		}
+	}
+	return result;
+}
+
+EncoderInfoSPtr EncoderOptionsCache::getEncoderInfo(const std::wstring& encoderId) {
+	std::lock_guard<std::mutex> lock(mMutex);
+	EncoderInfoSPtr& encoderInfo = mEncoderInfos[encoderId];
+	if (!encoderInfo)
+		encoderInfo.reset(prt::createEncoderInfo(encoderId.c_str()), PRTDestroyer());
+	return encoderInfo;
+}
+
+/**
+ * Drops the encoder infos and validated options, must be called before PRT shuts down.
+ */
+void EncoderOptionsCache::clear() {
+	std::lock_guard<std::mutex> lock(mMutex);
+	mEncoderInfos.clear();
+	mIndex.clear();
+	mEntries.clear();
+}
+
+size_t EncoderOptionsCache::getHitCount() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mHits;
+}
+
+size_t EncoderOptionsCache::getMissCount() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mMisses;
+}
+
+size_t EncoderOptionsCache::getEntryCount() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mEntries.size();
+}
@@ -0,0 +1,64 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#pragma once
+
+#include "types.h"
+
+#include "pybind11/pybind11.h"
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * Process-wide cache of encoder infos per encoder ID and of validated encoder options, keyed by the encoder ID and the
+ * content of the unvalidated options. Repeated generate calls with the same options skip creating the encoder info
+ * and validating the options.
+ */
+class EncoderOptionsCache {
+public:
+	static EncoderOptionsCache& get();
+
+	EncoderOptionsCache() = default;
+	EncoderOptionsCache(const EncoderOptionsCache&) = delete;
+	EncoderOptionsCache& operator=(const EncoderOptionsCache&) = delete;
+	~EncoderOptionsCache() = default;
+
+	AttributeMapSPtr getValidatedOptions(const std::wstring& encoderId, const pybind11::dict& options);
+	void clear();
+
+	size_t getHitCount() const;
+	size_t getMissCount() const;
+	size_t getEntryCount() const;
+
+private:
+	using EntryList = std::list<std::pair<std::string, AttributeMapSPtr>>;
+
+	EncoderInfoSPtr getEncoderInfo(const std::wstring& encoderId);
+
+	mutable std::mutex mMutex;
+	std::unordered_map<std::wstring, EncoderInfoSPtr> mEncoderInfos;
+	EntryList mEntries; // most recently used first
+	std::unordered_map<std::string, EntryList::iterator> mIndex;
+	size_t mHits = 0;
+	size_t mMisses = 0;
+};
@@ -19,6 +19,71 @@
 
 #include "GeneratedModel.h"
 
+#include <type_traits>
+
+namespace py = pybind11;
+
+namespace {
+
+template <typename T>
+py::list toPyList(const std::vector<T>& values, size_t begin, size_t end) {
+	py::list list(end - begin);
+	for (size_t i = begin; i < end; i++)
+		list[i - begin] = py::cast(static_cast<T>(values[i]));
+	return list;
+}
+
+/**
+ * Wraps a payload buffer into a read-only NumPy array without copying, the array keeps the payload alive.
+ */
+template <typename T>
+py::array_t<T> toReadOnlyArray(const GeneratedPayloadPtr& payload, const std::vector<T>& buffer, size_t columns) {
+	const size_t rows = buffer.size() / columns;
+	std::vector<py::ssize_t> shape = {static_cast<py::ssize_t>(rows)};
+	std::vector<py::ssize_t> strides = {static_cast<py::ssize_t>(columns * sizeof(T))};
+	if (columns > 1) {
+		shape.push_back(static_cast<py::ssize_t>(columns));
+		strides.push_back(static_cast<py::ssize_t>(sizeof(T)));
+	}
+
+	py::array_t<T> array;
+	if (buffer.empty()) {
+		// empty vectors may not have allocated any memory, there is nothing to keep alive
+		array = py::array_t<T>(shape, strides);
+	}
+	else {
+		py::capsule base(new GeneratedPayloadPtr(payload),
+		                 [](void* p) { delete static_cast<GeneratedPayloadPtr*>(p); });
+		array = py::array_t<T>(shape, strides, buffer.data(), base);
+	}
+	array.attr("flags").attr("writeable") = false;
+	return array;
+}
+
+} // namespace
+
+// array values with several rows become nested lists
+py::object GeneratedPayload::toPyObject(const GeneratedPayload::Attribute& attribute) {
+	return std::visit(
+	        [&attribute](const auto& value) -> py::object {
+		        using V = std::decay_t<decltype(value)>;
+		        if constexpr (std::is_same_v<V, bool> || std::is_same_v<V, double> || std::is_same_v<V, std::wstring>) {
+			        return py::cast(value);
+		        }
+		        else {
+			        if (attribute.mRows <= 1)
+				        return toPyList(value, 0, value.size());
+
+			        const size_t nCol = value.size() / attribute.mRows;
+			        py::list rows(attribute.mRows);
+			        for (size_t r = 0; r < attribute.mRows; r++)
+				        rows[r] = toPyList(value, r * nCol, (r + 1) * nCol);
+			        return rows;
+		        }
+	        },
+	        attribute.mValue);
+}
+
 GeneratedModel::GeneratedModel(const size_t& initShapeIdx, GeneratedPayloadPtr payload)
     : mInitialShapeIndex(initShapeIdx), mPayload(payload) {}
 
@@ -34,8 +99,26 @@ const Indices& GeneratedModel::getIndices() const {
 const Indices& GeneratedModel::getFaces() const {
 	return mPayload->mFaces;
 }
-const pybind11::dict& GeneratedModel::getReport() const {
-	return mPayload->mCGAReport;
+py::array_t<double> GeneratedModel::getVerticesArray() const {
+	return toReadOnlyArray(mPayload, mPayload->mVertices, 3);
+}
+py::array_t<uint32_t> GeneratedModel::getIndicesArray() const {
+	return toReadOnlyArray(mPayload, mPayload->mIndices, 1);
+}
+py::array_t<uint32_t> GeneratedModel::getFacesArray() const {
+	return toReadOnlyArray(mPayload, mPayload->mFaces, 1);
+}
+const GeneratedPayloadPtr& GeneratedModel::getPayload() const {
+	return mPayload;
+}
+pybind11::dict GeneratedModel::getReport() const {
+	if (!mPayload->mCGAReportDict) {
+		py::dict report;
+		for (const auto& entry : mPayload->mCGAReport)
+			report[py::cast(entry.first)] = std::visit([](const auto& value) { return py::cast(value); }, entry.second);
+		mPayload->mCGAReportDict = std::move(report);
+	}
+	return py::reinterpret_borrow<py::dict>(mPayload->mCGAReportDict);
 }
 const std::wstring& GeneratedModel::getCGAPrints() const {
 	return mPayload->mCGAPrints;
@@ -43,6 +126,12 @@ const std::wstring& GeneratedModel::getCGAPrints() const {
 const std::vector<std::wstring>& GeneratedModel::getCGAErrors() const {
 	return mPayload->mCGAErrors;
 }
-const pybind11::dict& GeneratedModel::getAttributes() const {
-	return mPayload->mAttrVal;
+pybind11::dict GeneratedModel::getAttributes() const {
+	if (!mPayload->mAttrValDict) {
+		py::dict attributes;
+		for (const GeneratedPayload::Attribute& attribute : mPayload->mAttrVal)
+			attributes[py::cast(attribute.mKey)] = toPyObject(attribute);
+		mPayload->mAttrValDict = std::move(attributes);
+	}
+	return py::reinterpret_borrow<py::dict>(mPayload->mAttrValDict);
 }
@@ -22,6 +22,7 @@
 #include "GeneratedPayload.h"
 #include "types.h"
 
+#include "pybind11/numpy.h"
 #include "pybind11/pybind11.h"
 
 #include <cstddef>
@@ -38,10 +39,14 @@ public:
 	const Coordinates& getVertices() const;
 	const Indices& getIndices() const;
 	const Indices& getFaces() const;
-	const pybind11::dict& getReport() const;
+	pybind11::array_t<double> getVerticesArray() const;
+	pybind11::array_t<uint32_t> getIndicesArray() const;
+	pybind11::array_t<uint32_t> getFacesArray() const;
+	pybind11::dict getReport() const;
 	const std::wstring& getCGAPrints() const;
 	const std::vector<std::wstring>& getCGAErrors() const;
-	const pybind11::dict& getAttributes() const;
+	pybind11::dict getAttributes() const;
+	const GeneratedPayloadPtr& getPayload() const;
 
 private:
 	size_t mInitialShapeIndex;
@@ -0,0 +1,124 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#include "GeneratedModelIterator.h"
+#include "ModelGenerator.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace py = pybind11;
+
+GeneratedModelIterator::GeneratedModelIterator(py::object generator, ShapeAttributes shapeAttributes,
+                                               const std::filesystem::path& rulePackagePath,
+                                               GeometryEncoders geometryEncoders, size_t numThreads,
+                                               size_t batchSize, size_t maxBatchesInFlight)
+    : mGenerator(std::move(generator)), mShapeAttributes(std::move(shapeAttributes)),
+      mGeometryEncoders(std::move(geometryEncoders)), mRulePackagePath(rulePackagePath), mNumThreads(numThreads),
+      mBatchSize(batchSize), mMaxBatchesInFlight(maxBatchesInFlight) {
+	if (mBatchSize == 0)
+		throw std::invalid_argument("batchSize must be greater than zero");
+	if (mMaxBatchesInFlight == 0)
+		throw std::invalid_argument("maxBatchesInFlight must be greater than zero");
+
+	mShapeCount = mGenerator.cast<ModelGenerator&>().getInitialShapeCount();
+	mProducer = std::thread(&GeneratedModelIterator::produce, this);
+}
+
+GeneratedModelIterator::~GeneratedModelIterator() {
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mCancelled = true;
+	}
+	mCondition.notify_all();
+
+	if (mProducer.joinable()) {
+		// the producer needs the GIL to finish its current batch
+		py::gil_scoped_release release;
+		mProducer.join();
+	}
+}
+
+std::vector<GeneratedModel> GeneratedModelIterator::next() {
+	std::optional<std::vector<GeneratedModel>> batch;
+	std::optional<std::string> error;
+	{
+		py::gil_scoped_release release;
+		std::unique_lock<std::mutex> lock(mMutex);
+		mCondition.wait(lock, [this]() { return !mBatches.empty() || mDone; });
+		if (!mBatches.empty()) {
+			batch = std::move(mBatches.front());
+			mBatches.pop_front();
+		}
+		else {
+			error.swap(mError);
+		}
+	}
+	mCondition.notify_all();
+
+	if (batch)
+		return std::move(*batch);
+	if (error)
+		throw std::runtime_error(*error);
+	throw py::stop_iteration();
+}
+
+void GeneratedModelIterator::produce() {
+	for (size_t firstShape = 0; firstShape < mShapeCount; firstShape += mBatchSize) {
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mCondition.wait(lock, [this]() { return mCancelled || mBatches.size() < mMaxBatchesInFlight; });
+			if (mCancelled)
+				break;
+		}
+
+		std::vector<GeneratedModel> batch;
+		try {
+			py::gil_scoped_acquire acquire;
+			ModelGenerator& generator = mGenerator.cast<ModelGenerator&>();
+			const size_t shapeCount = std::min(mBatchSize, mShapeCount - firstShape);
+			batch = generator.generateModelBatch(mShapeAttributes, mRulePackagePath, mGeometryEncoders, mNumThreads,
+			                                     firstShape, shapeCount);
+
+			// generateModelBatch logs its errors and returns no models
+			if (batch.empty() && hasPyEncoder(mGeometryEncoders))
+				throw std::runtime_error("could not generate the models of initial shapes " +
+				                         std::to_string(firstShape) + " to " +
+				                         std::to_string(firstShape + shapeCount - 1) + ", see the log for details.");
+		}
+		catch (const std::exception& e) {
+			std::lock_guard<std::mutex> lock(mMutex);
+			mError = e.what();
+			break;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mBatches.push_back(std::move(batch));
+		}
+		mCondition.notify_all();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mDone = true;
+	}
+	mCondition.notify_all();
+}
@@ -0,0 +1,73 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#pragma once
+
+#include "GeneratedModel.h"
+#include "ModelGenerator.h"
+#include "ShapeAttributes.h"
+
+#include "pybind11/pybind11.h"
+
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Python iterator over batches of generated models. A producer thread generates the batches in initial shape order
+ * while Python consumes the previous ones, at most maxBatchesInFlight batches are generated but not yet consumed.
+ */
+class GeneratedModelIterator {
+public:
+	GeneratedModelIterator(pybind11::object generator, ShapeAttributes shapeAttributes,
+	                       const std::filesystem::path& rulePackagePath, GeometryEncoders geometryEncoders,
+	                       size_t numThreads, size_t batchSize, size_t maxBatchesInFlight);
+	GeneratedModelIterator(const GeneratedModelIterator&) = delete;
+	GeneratedModelIterator& operator=(const GeneratedModelIterator&) = delete;
+	~GeneratedModelIterator();
+
+	std::vector<GeneratedModel> next();
+
+private:
+	void produce();
+
+	// Python objects, only accessed with the GIL held
+	pybind11::object mGenerator;
+	ShapeAttributes mShapeAttributes;
+	GeometryEncoders mGeometryEncoders;
+
+	const std::filesystem::path mRulePackagePath;
+	const size_t mNumThreads;
+	const size_t mBatchSize;
+	const size_t mMaxBatchesInFlight;
+	size_t mShapeCount = 0;
+
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+	std::deque<std::vector<GeneratedModel>> mBatches;
+	std::optional<std::string> mError;
+	bool mDone = false;
+	bool mCancelled = false;
+	std::thread mProducer;
+};
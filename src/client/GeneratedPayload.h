@@ -25,16 +25,38 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <variant>
 #include <vector>
 
+/**
+ * Generation results of one initial shape. The payload is filled by the callbacks while the GIL is released, so all
+ * results are stored in native buffers. The Python objects are only created on first access by GeneratedModel.
+ */
 struct GeneratedPayload {
+	using ReportValue = std::variant<bool, double, std::wstring>;
+	using AttributeValue = std::variant<bool, double, std::wstring, std::vector<bool>, std::vector<double>,
+	                                    std::vector<std::wstring>>;
+
+	struct Attribute {
+		std::wstring mKey; // without the default style prefix
+		AttributeValue mValue;
+		size_t mRows = 1; // array values with more than one row are stored row by row
+	};
+
+	static pybind11::object toPyObject(const Attribute& attribute);
+
 	Coordinates mVertices;
 	Indices mIndices;
 	Indices mFaces;
-	pybind11::dict mCGAReport;
+	std::vector<std::pair<std::wstring, ReportValue>> mCGAReport;
 	std::wstring mCGAPrints;
 	std::vector<std::wstring> mCGAErrors;
-	pybind11::dict mAttrVal;
+	std::vector<Attribute> mAttrVal;
+
+	// lazily converted Python dicts, null until requested (and always accessed with the GIL held)
+	pybind11::object mCGAReportDict;
+	pybind11::object mAttrValDict;
 };
 
-using GeneratedPayloadPtr = std::shared_ptr<GeneratedPayload>;
\ No newline at end of file
+using GeneratedPayloadPtr = std::shared_ptr<GeneratedPayload>;
@@ -0,0 +1,180 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#include "GeometryCache.h"
+#include "OBJReader.h"
+#include "logging.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace {
+
+std::string readFile(const std::filesystem::path& path) {
+	std::ifstream in(path, std::ios::binary);
+	if (!in)
+		throw std::runtime_error("could not open file");
+	return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+} // namespace
+
+GeometryCache& GeometryCache::get() {
+	static GeometryCache theCache;
+	return theCache;
+}
+
+bool GeometryCache::isSupported(const std::filesystem::path& path) {
+	std::string extension = path.extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(),
+	               [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	return extension == ".obj";
+}
+
+/**
+ * Returns null if the file cannot be read or decoded, callers fall back to resolving the file with PRT. Concurrent
+ * misses on the same file may decode it twice. Does not need the GIL.
+ */
+GeometryCache::GeometryPtr GeometryCache::getGeometry(const std::filesystem::path& path, bool splitObjects) {
+	if (!isSupported(path))
+		return {};
+
+	std::error_code ec;
+	const std::filesystem::path canonicalPath = std::filesystem::canonical(path, ec);
+	FileStamp stamp;
+	if (!ec)
+		stamp.mSize = std::filesystem::file_size(canonicalPath, ec);
+	if (!ec)
+		stamp.mModificationTime = std::filesystem::last_write_time(canonicalPath, ec);
+	if (ec) {
+		LOG_DBG << "could not read file status of initial shape geometry " << path << ": " << ec.message();
+		return {};
+	}
+
+	const std::wstring key = canonicalPath.wstring() + (splitObjects ? L"|objects" : L"");
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		const auto it = mIndex.find(key);
+		if (it != mIndex.end() && it->second->mStamp == stamp) {
+			mEntries.splice(mEntries.begin(), mEntries, it->second);
+			mHits++;
+			return it->second->mGeometry;
+		}
+		mMisses++;
+	}
+
+	GeometryPtr geometry;
+	try {
+		OBJReader::Result result = OBJReader::read(readFile(canonicalPath), splitObjects);
+		geometry = std::make_shared<const Geometry>(Geometry{std::move(result.mShapes), result.mHasAppearance});
+	}
+	catch (const std::exception& e) {
+		LOG_DBG << "could not decode initial shape geometry " << canonicalPath << ": " << e.what();
+		return {};
+	}
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	const auto it = mIndex.find(key);
+	if (it != mIndex.end()) {
+		mBytes -= it->second->mBytes;
+		mEntries.erase(it->second);
+		mIndex.erase(it);
+	}
+	mEntries.push_front({key, stamp, geometry, geometry->mShapes.getByteCount()});
+	mIndex.emplace(key, mEntries.begin());
+	mBytes += mEntries.front().mBytes;
+	enforceBudget();
+	return geometry;
+}
+
+/**
+ * Drops the decoded geometry of a file, in both the single shape and the split objects variant. Returns false if the
+ * file was not cached.
+ */
+bool GeometryCache::flushEntry(const std::filesystem::path& path) {
+	std::error_code ec;
+	const std::filesystem::path canonicalPath = std::filesystem::canonical(path, ec);
+	if (ec)
+		return false;
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	bool flushed = false;
+	for (const std::wstring& key : {canonicalPath.wstring(), canonicalPath.wstring() + L"|objects"}) {
+		const auto it = mIndex.find(key);
+		if (it != mIndex.end()) {
+			mBytes -= it->second->mBytes;
+			mEntries.erase(it->second);
+			mIndex.erase(it);
+			flushed = true;
+		}
+	}
+	return flushed;
+}
+
+void GeometryCache::clear() {
+	std::lock_guard<std::mutex> lock(mMutex);
+	mEntries.clear();
+	mIndex.clear();
+	mBytes = 0;
+}
+
+void GeometryCache::setBudget(uintmax_t budget) {
+	std::lock_guard<std::mutex> lock(mMutex);
+	mBudget = budget;
+	enforceBudget();
+}
+
+uintmax_t GeometryCache::getBudget() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mBudget;
+}
+
+uintmax_t GeometryCache::getByteCount() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mBytes;
+}
+
+size_t GeometryCache::getHitCount() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mHits;
+}
+
+size_t GeometryCache::getMissCount() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mMisses;
+}
+
+size_t GeometryCache::getEntryCount() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mEntries.size();
+}
+
+// expects mMutex to be held, the most recently decoded geometry is never evicted
+void GeometryCache::enforceBudget() {
+	while (mBudget > 0 && mBytes > mBudget && mEntries.size() > 1) {
+		mBytes -= mEntries.back().mBytes;
+		mIndex.erase(mEntries.back().mKey);
+		mEntries.pop_back();
+	}
+}
@@ -0,0 +1,92 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#pragma once
+
+#include "InitialShapeBatch.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Process-wide cache of decoded initial shape geometry files, shared by all model generators. Entries are keyed by the
+ * canonical file path and are invalidated as soon as the size or the modification time of the file changes. The least
+ * recently used entries are evicted once the decoded geometry exceeds the memory budget. Only OBJ files are decoded
+ * natively, other formats are resolved by PRT.
+ */
+class GeometryCache {
+public:
+	struct Geometry {
+		InitialShapeBatch mShapes;
+		bool mHasAppearance = false; // texture coordinates or materials, which are not decoded
+	};
+	using GeometryPtr = std::shared_ptr<const Geometry>;
+
+	static GeometryCache& get();
+	static bool isSupported(const std::filesystem::path& path);
+
+	GeometryCache() = default;
+	GeometryCache(const GeometryCache&) = delete;
+	GeometryCache& operator=(const GeometryCache&) = delete;
+	~GeometryCache() = default;
+
+	GeometryPtr getGeometry(const std::filesystem::path& path, bool splitObjects);
+	bool flushEntry(const std::filesystem::path& path);
+	void clear();
+
+	void setBudget(uintmax_t budget);
+	uintmax_t getBudget() const;
+	uintmax_t getByteCount() const;
+	size_t getHitCount() const;
+	size_t getMissCount() const;
+	size_t getEntryCount() const;
+
+private:
+	struct FileStamp {
+		uintmax_t mSize = 0;
+		std::filesystem::file_time_type mModificationTime;
+
+		bool operator==(const FileStamp& other) const {
+			return mSize == other.mSize && mModificationTime == other.mModificationTime;
+		}
+	};
+
+	struct Entry {
+		std::wstring mKey;
+		FileStamp mStamp;
+		GeometryPtr mGeometry;
+		uintmax_t mBytes = 0;
+	};
+	using EntryList = std::list<Entry>;
+
+	void enforceBudget();
+
+	mutable std::mutex mMutex;
+	EntryList mEntries; // most recently used first
+	std::unordered_map<std::wstring, EntryList::iterator> mIndex;
+	uintmax_t mBudget = 256 * 1024 * 1024; // zero means unbounded
+	uintmax_t mBytes = 0;
+	size_t mHits = 0;
+	size_t mMisses = 0;
+};
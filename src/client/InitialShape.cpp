@@ -20,48 +20,63 @@
 #include "InitialShape.h"
 
 #include <numeric>
+#include <utility>
 
-InitialShape::InitialShape(const Coordinates& vert) : mVertices(vert), mPathFlag(false) {
-	mIndices.resize(vert.size() / 3);
-	std::iota(std::begin(mIndices), std::end(mIndices), 0);
-	mFaceCounts.resize(1, (uint32_t)mIndices.size());
-}
-
-InitialShape::InitialShape(const Coordinates& vert, const Indices& ind, const Indices& faceCnt,
-                           const HoleIndices& holes = {{}})
-    : mVertices(vert), mIndices(ind), mFaceCounts(faceCnt), mPathFlag(false) {
+namespace {
 
+void appendHoles(const HoleIndices& holes, Indices& flatHoles) {
 	for (auto& holesPerFaceWithHoles : holes) {
-		mHoles.insert(mHoles.end(), holesPerFaceWithHoles.begin(), holesPerFaceWithHoles.end());
-		mHoles.push_back(UINT32_MAX);
+		flatHoles.insert(flatHoles.end(), holesPerFaceWithHoles.begin(), holesPerFaceWithHoles.end());
+		flatHoles.push_back(UINT32_MAX);
 	}
 }
 
+} // namespace
+
+InitialShape::InitialShape(Coordinates vert) : mPathFlag(false) {
+	auto geometry = std::make_shared<Geometry>();
+	geometry->mVertices = std::move(vert);
+	geometry->mIndices.resize(geometry->mVertices.size() / 3);
+	std::iota(std::begin(geometry->mIndices), std::end(geometry->mIndices), 0);
+	geometry->mFaceCounts.resize(1, (uint32_t)geometry->mIndices.size());
+	mGeometry = std::move(geometry);
+}
+
+InitialShape::InitialShape(Coordinates vert, Indices ind, Indices faceCnt, const HoleIndices& holes = {{}})
+    : mPathFlag(false) {
+	auto geometry = std::make_shared<Geometry>();
+	geometry->mVertices = std::move(vert);
+	geometry->mIndices = std::move(ind);
+	geometry->mFaceCounts = std::move(faceCnt);
+	appendHoles(holes, geometry->mHoles);
+	mGeometry = std::move(geometry);
+}
+
 InitialShape::InitialShape(const std::string& initShapePath) : mPath(initShapePath), mPathFlag(true) {}
 
 const double* InitialShape::getVertices() const {
-	return mVertices.data();
+	return mGeometry ? mGeometry->mVertices.data() : nullptr;
 }
 size_t InitialShape::getVertexCount() const {
-	return mVertices.size();
+	return mGeometry ? mGeometry->mVertices.size() : 0;
 }
 const uint32_t* InitialShape::getIndices() const {
-	return mIndices.data();
+	return mGeometry ? mGeometry->mIndices.data() : nullptr;
 }
 size_t InitialShape::getIndexCount() const {
-	return mIndices.size();
+	return mGeometry ? mGeometry->mIndices.size() : 0;
 }
 const uint32_t* InitialShape::getFaceCounts() const {
-	return mFaceCounts.data();
+	return mGeometry ? mGeometry->mFaceCounts.data() : nullptr;
 }
 size_t InitialShape::getFaceCountsCount() const {
-	return mFaceCounts.size();
+	return mGeometry ? mGeometry->mFaceCounts.size() : 0;
 }
 const uint32_t* InitialShape::getHoles() const {
-	return mHoles.data();
+	return mGeometry ? mGeometry->mHoles.data() : nullptr;
 }
 size_t InitialShape::getHolesCount() const {
-	return mHoles.size();
+	return mGeometry ? mGeometry->mHoles.size() : 0;
 }
 const std::string& InitialShape::getPath() const {
 	return mPath;
@@ -22,14 +22,14 @@
 #include "types.h"
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 class InitialShape {
 public:
-	explicit InitialShape(const Coordinates& vert);
-	explicit InitialShape(const Coordinates& vert, const Indices& ind, const Indices& faceCnt,
-	                      const HoleIndices& holes);
+	explicit InitialShape(Coordinates vert);
+	explicit InitialShape(Coordinates vert, Indices ind, Indices faceCnt, const HoleIndices& holes);
 	explicit InitialShape(const std::string& path);
 	~InitialShape() = default;
 
@@ -45,10 +45,15 @@ public:
 	bool getPathFlag() const;
 
 protected:
-	const Coordinates mVertices;
-	Indices mIndices;
-	Indices mFaceCounts;
-	Indices mHoles;
+	struct Geometry {
+		Coordinates mVertices;
+		Indices mIndices;
+		Indices mFaceCounts;
+		Indices mHoles;
+	};
+
+	// shared and immutable, copies of an initial shape do not duplicate the geometry
+	std::shared_ptr<const Geometry> mGeometry;
 	const std::string mPath;
 	const bool mPathFlag;
 };
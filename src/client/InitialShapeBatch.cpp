@@ -0,0 +1,255 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#include "InitialShapeBatch.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+void validateOffsets(const InitialShapeBatch::Offsets& offsets, size_t shapeCount, size_t total, const char* name) {
+	if (offsets.size() != shapeCount + 1)
+		throw std::invalid_argument(std::string(name) + " must have one entry more than there are shapes.");
+	if (offsets.front() != 0 || offsets.back() != total)
+		throw std::invalid_argument(std::string(name) + " must start at 0 and end at the size of the buffer.");
+	for (size_t i = 1; i < offsets.size(); i++) {
+		if (offsets[i] < offsets[i - 1])
+			throw std::invalid_argument(std::string(name) + " must not decrease.");
+	}
+}
+
+// shoelace formula on the x/y plane of the input, positive for counter-clockwise rings
+double getSignedArea(const double* coordinates, size_t dimensions, size_t first, size_t last) {
+	double area = 0.0;
+	for (size_t v = first; v < last; v++) {
+		const double* p0 = coordinates + v * dimensions;
+		const double* p1 = coordinates + ((v + 1 < last) ? v + 1 : first) * dimensions;
+		area += p0[0] * p1[1] - p1[0] * p0[1];
+	}
+	return 0.5 * area;
+}
+
+// the shapes are passed to prt::InitialShapeBuilder::setGeometry as they are
+void validateShapes(const InitialShapeBatch::Buffers& buffers, size_t shapeCount) {
+	for (size_t s = 0; s < shapeCount; s++) {
+		const uint64_t vertexCount = buffers.mVertexOffsets[s + 1] - buffers.mVertexOffsets[s];
+		const uint64_t firstIndex = buffers.mIndexOffsets[s];
+		const uint64_t lastIndex = buffers.mIndexOffsets[s + 1];
+
+		uint64_t faceIndexCount = 0;
+		for (uint64_t f = buffers.mFaceCountOffsets[s]; f < buffers.mFaceCountOffsets[s + 1]; f++)
+			faceIndexCount += buffers.mFaceCounts[f];
+		if (faceIndexCount != lastIndex - firstIndex)
+			throw std::invalid_argument("the face counts of shape " + std::to_string(s) +
+			                            " do not add up to its number of indices.");
+
+		for (uint64_t i = firstIndex; i < lastIndex; i++) {
+			if (buffers.mIndices[i] >= vertexCount)
+				throw std::invalid_argument("shape " + std::to_string(s) + " has a vertex index out of range.");
+		}
+	}
+}
+
+} // namespace
+
+InitialShapeBatch::InitialShapeBatch(Buffers&& buffers) {
+	if (buffers.mVertexOffsets.empty())
+		throw std::invalid_argument("vertex offsets must not be empty.");
+	if (buffers.mVertices.size() % 3 != 0)
+		throw std::invalid_argument("the number of vertex coordinates must be a multiple of 3.");
+
+	const size_t shapeCount = buffers.mVertexOffsets.size() - 1;
+	validateOffsets(buffers.mVertexOffsets, shapeCount, buffers.mVertices.size() / 3, "vertex offsets");
+	validateOffsets(buffers.mIndexOffsets, shapeCount, buffers.mIndices.size(), "index offsets");
+	validateOffsets(buffers.mFaceCountOffsets, shapeCount, buffers.mFaceCounts.size(), "face count offsets");
+	if (!buffers.mHoleOffsets.empty() || !buffers.mHoles.empty())
+		validateOffsets(buffers.mHoleOffsets, shapeCount, buffers.mHoles.size(), "hole offsets");
+	validateShapes(buffers, shapeCount);
+
+	mBuffers = std::make_shared<const Buffers>(std::move(buffers));
+	mFirst = 0;
+	mCount = shapeCount;
+}
+
+/**
+ * Builds a batch from polygons in GIS conventions (x/y plane with z up), e.g. from GeoArrow or WKB. Every polygon
+ * becomes one face, its first ring is the exterior and the other rings are holes. The axes are swapped to the y-up
+ * convention of PRT, (x, y, z) becomes (x, z, -y), and the rings are reordered if needed so exteriors are
+ * counter-clockwise and holes clockwise when seen from above. A closing vertex repeating the first one is dropped.
+ */
+InitialShapeBatch InitialShapeBatch::fromPolygons(const Coordinates& coordinates, size_t dimensions,
+                                                  const Offsets& ringOffsets, const Offsets& polygonOffsets,
+                                                  const Offsets& shapeOffsets) {
+	if (dimensions != 2 && dimensions != 3)
+		throw std::invalid_argument("only 2D or 3D coordinates are supported.");
+	if (coordinates.size() % dimensions != 0)
+		throw std::invalid_argument("the number of coordinates must be a multiple of the dimensions.");
+	if (ringOffsets.empty() || polygonOffsets.empty() || shapeOffsets.empty())
+		throw std::invalid_argument("ring, polygon and shape offsets must not be empty.");
+	validateOffsets(ringOffsets, ringOffsets.size() - 1, coordinates.size() / dimensions, "ring offsets");
+	validateOffsets(polygonOffsets, polygonOffsets.size() - 1, ringOffsets.size() - 1, "polygon offsets");
+	validateOffsets(shapeOffsets, shapeOffsets.size() - 1, polygonOffsets.size() - 1, "shape offsets");
+
+	const size_t shapeCount = shapeOffsets.size() - 1;
+	Buffers buffers;
+	buffers.mVertices.reserve(coordinates.size() / dimensions * 3);
+	buffers.mIndices.reserve(coordinates.size() / dimensions);
+	buffers.mFaceCounts.reserve(ringOffsets.size() - 1);
+	buffers.mVertexOffsets.reserve(shapeCount + 1);
+	buffers.mIndexOffsets.reserve(shapeCount + 1);
+	buffers.mFaceCountOffsets.reserve(shapeCount + 1);
+	buffers.mHoleOffsets.reserve(shapeCount + 1);
+	buffers.mVertexOffsets.push_back(0);
+	buffers.mIndexOffsets.push_back(0);
+	buffers.mFaceCountOffsets.push_back(0);
+	buffers.mHoleOffsets.push_back(0);
+
+	const double* coords = coordinates.data();
+	for (size_t s = 0; s < shapeCount; s++) {
+		uint32_t shapeVertexCount = 0;
+		uint32_t shapeFaceCount = 0;
+
+		for (size_t p = shapeOffsets[s]; p < shapeOffsets[s + 1]; p++) {
+			const uint32_t exteriorIndex = shapeFaceCount;
+			for (size_t r = polygonOffsets[p]; r < polygonOffsets[p + 1]; r++) {
+				const size_t first = ringOffsets[r];
+				size_t last = ringOffsets[r + 1];
+				if (last - first > 1 && std::memcmp(coords + first * dimensions, coords + (last - 1) * dimensions,
+				                                    dimensions * sizeof(double)) == 0)
+					last--;
+
+				const bool exterior = (r == polygonOffsets[p]);
+				const bool counterClockwise = getSignedArea(coords, dimensions, first, last) > 0.0;
+				const bool reverse = (counterClockwise != exterior);
+				for (size_t i = 0; i < last - first; i++) {
+					const double* v = coords + (reverse ? last - 1 - i : first + i) * dimensions;
+					buffers.mVertices.push_back(v[0]);
+					buffers.mVertices.push_back(dimensions == 3 ? v[2] : 0.0);
+					buffers.mVertices.push_back(-v[1]);
+					buffers.mIndices.push_back(shapeVertexCount++);
+				}
+				buffers.mFaceCounts.push_back(static_cast<uint32_t>(last - first));
+
+				if (!exterior) {
+					if (r == polygonOffsets[p] + 1)
+						buffers.mHoles.push_back(exteriorIndex);
+					buffers.mHoles.push_back(shapeFaceCount);
+				}
+				shapeFaceCount++;
+			}
+			if (polygonOffsets[p + 1] - polygonOffsets[p] > 1)
+				buffers.mHoles.push_back(UINT32_MAX);
+		}
+
+		buffers.mVertexOffsets.push_back(buffers.mVertices.size() / 3);
+		buffers.mIndexOffsets.push_back(buffers.mIndices.size());
+		buffers.mFaceCountOffsets.push_back(buffers.mFaceCounts.size());
+		buffers.mHoleOffsets.push_back(buffers.mHoles.size());
+	}
+
+	return InitialShapeBatch(std::move(buffers));
+}
+
+/**
+ * Builds a batch from polygon rings without explicit polygon structure, e.g. from ArcGIS. Within a shape, rings with
+ * the same orientation as the first ring start a new polygon, the others are holes of the preceding one.
+ */
+InitialShapeBatch InitialShapeBatch::fromRings(const Coordinates& coordinates, size_t dimensions,
+                                               const Offsets& ringOffsets, const Offsets& shapeOffsets) {
+	if (dimensions != 2 && dimensions != 3)
+		throw std::invalid_argument("only 2D or 3D coordinates are supported.");
+	if (ringOffsets.empty() || shapeOffsets.empty())
+		throw std::invalid_argument("ring and shape offsets must not be empty.");
+	validateOffsets(ringOffsets, ringOffsets.size() - 1, coordinates.size() / dimensions, "ring offsets");
+	validateOffsets(shapeOffsets, shapeOffsets.size() - 1, ringOffsets.size() - 1, "shape offsets");
+
+	Offsets polygonOffsets;
+	Offsets polygonShapeOffsets;
+	polygonOffsets.reserve(ringOffsets.size());
+	polygonShapeOffsets.reserve(shapeOffsets.size());
+	polygonShapeOffsets.push_back(0);
+
+	const double* coords = coordinates.data();
+	for (size_t s = 0; s + 1 < shapeOffsets.size(); s++) {
+		bool firstRingCounterClockwise = false;
+		for (size_t r = shapeOffsets[s]; r < shapeOffsets[s + 1]; r++) {
+			const bool counterClockwise = getSignedArea(coords, dimensions, ringOffsets[r], ringOffsets[r + 1]) > 0.0;
+			if (r == shapeOffsets[s])
+				firstRingCounterClockwise = counterClockwise;
+			if (counterClockwise == firstRingCounterClockwise)
+				polygonOffsets.push_back(r);
+		}
+		polygonShapeOffsets.push_back(polygonOffsets.size());
+	}
+	polygonOffsets.push_back(ringOffsets.size() - 1);
+
+	return fromPolygons(coordinates, dimensions, ringOffsets, polygonOffsets, polygonShapeOffsets);
+}
+
+InitialShapeBatch::InitialShapeBatch(std::shared_ptr<const Buffers> buffers, size_t first, size_t count)
+    : mBuffers(std::move(buffers)), mFirst(first), mCount(count) {}
+
+size_t InitialShapeBatch::size() const {
+	return mCount;
+}
+
+InitialShapeBatch::Shape InitialShapeBatch::getShape(size_t index) const {
+	if (index >= mCount)
+		throw std::out_of_range("initial shape index is out of range.");
+
+	const Buffers& b = *mBuffers;
+	const size_t i = mFirst + index;
+	Shape shape;
+	shape.mVertices = b.mVertices.data() + 3 * b.mVertexOffsets[i];
+	shape.mVertexCoordsCount = 3 * (b.mVertexOffsets[i + 1] - b.mVertexOffsets[i]);
+	shape.mIndices = b.mIndices.data() + b.mIndexOffsets[i];
+	shape.mIndexCount = b.mIndexOffsets[i + 1] - b.mIndexOffsets[i];
+	shape.mFaceCounts = b.mFaceCounts.data() + b.mFaceCountOffsets[i];
+	shape.mFaceCountsCount = b.mFaceCountOffsets[i + 1] - b.mFaceCountOffsets[i];
+	if (b.mHoleOffsets.empty()) {
+		shape.mHoles = nullptr;
+		shape.mHolesCount = 0;
+	}
+	else {
+		shape.mHoles = b.mHoles.data() + b.mHoleOffsets[i];
+		shape.mHolesCount = b.mHoleOffsets[i + 1] - b.mHoleOffsets[i];
+	}
+	return shape;
+}
+
+InitialShapeBatch InitialShapeBatch::slice(size_t first, size_t count) const {
+	if (first > mCount || count > mCount - first)
+		throw std::out_of_range("initial shape batch slice is out of range.");
+	return InitialShapeBatch(mBuffers, mFirst + first, count);
+}
+
+size_t InitialShapeBatch::getVertexCount() const {
+	return mBuffers->mVertexOffsets[mFirst + mCount] - mBuffers->mVertexOffsets[mFirst];
+}
+
+// the memory held by the shared buffers, including the shapes outside of this slice
+size_t InitialShapeBatch::getByteCount() const {
+	const Buffers& b = *mBuffers;
+	return b.mVertices.size() * sizeof(double) +
+	       (b.mIndices.size() + b.mFaceCounts.size() + b.mHoles.size()) * sizeof(uint32_t) +
+	       (b.mVertexOffsets.size() + b.mIndexOffsets.size() + b.mFaceCountOffsets.size() + b.mHoleOffsets.size()) *
+	               sizeof(uint64_t);
+}
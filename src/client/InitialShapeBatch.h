@@ -0,0 +1,79 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#pragma once
+
+#include "types.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Structure-of-arrays container for many initial shapes. All shapes share a few contiguous buffers, per-shape offset
+ * arrays (shape count + 1 entries each) delimit the geometry of every shape. Slices share the buffers.
+ */
+class InitialShapeBatch {
+public:
+	using Offsets = std::vector<uint64_t>;
+
+	struct Buffers {
+		Coordinates mVertices;
+		Indices mIndices; // relative to the first vertex of the shape
+		Indices mFaceCounts;
+		Indices mHoles; // PRT hole layout, i.e. the holes of each face terminated by UINT32_MAX
+		Offsets mVertexOffsets; // in vertices, not coordinates
+		Offsets mIndexOffsets;
+		Offsets mFaceCountOffsets;
+		Offsets mHoleOffsets; // may be empty if no shape has holes
+	};
+
+	struct Shape {
+		const double* mVertices;
+		size_t mVertexCoordsCount;
+		const uint32_t* mIndices;
+		size_t mIndexCount;
+		const uint32_t* mFaceCounts;
+		size_t mFaceCountsCount;
+		const uint32_t* mHoles;
+		size_t mHolesCount;
+	};
+
+	explicit InitialShapeBatch(Buffers&& buffers);
+
+	static InitialShapeBatch fromPolygons(const Coordinates& coordinates, size_t dimensions,
+	                                      const Offsets& ringOffsets, const Offsets& polygonOffsets,
+	                                      const Offsets& shapeOffsets);
+	static InitialShapeBatch fromRings(const Coordinates& coordinates, size_t dimensions, const Offsets& ringOffsets,
+	                                   const Offsets& shapeOffsets);
+
+	size_t size() const;
+	Shape getShape(size_t index) const;
+	InitialShapeBatch slice(size_t first, size_t count) const;
+
+	size_t getVertexCount() const;
+	size_t getByteCount() const;
+
+private:
+	InitialShapeBatch(std::shared_ptr<const Buffers> buffers, size_t first, size_t count);
+
+	std::shared_ptr<const Buffers> mBuffers;
+	size_t mFirst = 0;
+	size_t mCount = 0;
+};
@@ -18,11 +18,20 @@
  */
 
 #include "ModelGenerator.h"
+#include "CachePool.h"
+#include "EncoderOptionsCache.h"
+#include "GeometryCache.h"
 #include "PRTContext.h"
 #include "PyCallbacks.h"
+#include "RulePackageCache.h"
 #include "logging.h"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
 
 namespace {
 
@@ -34,10 +43,50 @@ const std::wstring ENCODER_ID_PYTHON = L"com.esri.pyprt.PyEncoder";
 
 constexpr const char* ENC_OPT_OUTPUT_PATH = "outputPath";
 
-void extractMainShapeAttributes(const py::dict& shapeAttr, int32_t& seed, std::wstring& shapeName,
-                                AttributeMapPtr& convertShapeAttr) {
-	convertShapeAttr = pcu::createAttributeMapFromPythonDict(
-	        shapeAttr, *(AttributeMapBuilderPtr(prt::AttributeMapBuilder::create())));
+// switches for the auxiliary encoders, they are not passed on to the geometry encoder
+constexpr const char* ENC_OPT_EMIT_ATTRIBUTES = "emitAttributes";
+constexpr const char* ENC_OPT_EMIT_PRINTS = "emitPrints";
+constexpr const char* ENC_OPT_EMIT_ERRORS = "emitErrors";
+constexpr const char* ENC_OPT_EMIT_REPORT = "emitReport"; // PyEncoder option
+
+bool getEmitOption(const py::dict& encOpt, const char* key) {
+	return !encOpt.contains(key) || encOpt[key].cast<bool>();
+}
+
+// all file encoders of a generate call write into the same output path, see validateGeometryEncoders
+FileOutputCallbacksPtr createFileOutputCallbacks(const GeometryEncoders& geometryEncoders) {
+	std::filesystem::path outputPath;
+	for (const GeometryEncoder& encoder : geometryEncoders) {
+		if (encoder.mName != ENCODER_ID_PYTHON && encoder.mOptions.contains(ENC_OPT_OUTPUT_PATH)) {
+			outputPath = encoder.mOptions[ENC_OPT_OUTPUT_PATH].cast<std::string>();
+			break;
+		}
+	}
+	if (outputPath.empty()) {
+		outputPath = std::filesystem::temp_directory_path() / "pyprt_fallback_output";
+		std::filesystem::create_directory(outputPath);
+		LOG_WRN << "Encoder option '" << ENC_OPT_OUTPUT_PATH
+		        << "' was not specified, falling back to system tmp directory:" << outputPath;
+	}
+	LOG_DBG << "got outputPath = " << outputPath;
+
+	if (!std::filesystem::is_directory(outputPath) || !std::filesystem::exists(outputPath)) {
+		LOG_ERR << "The directory specified by '" << ENC_OPT_OUTPUT_PATH
+		        << "' is not valid or does not exist: " << outputPath << std::endl;
+		return {};
+	}
+	return FileOutputCallbacksPtr{prt::FileOutputCallbacks::create(outputPath.wstring().c_str())};
+}
+
+// a few work units per thread balance heavy-tailed shape costs without too many prt::generate calls
+constexpr size_t WORK_UNITS_PER_THREAD = 8;
+
+size_t getWorkUnitSize(size_t itemCount, size_t threadCount) {
+	return (threadCount > 1) ? std::max<size_t>(1, itemCount / (threadCount * WORK_UNITS_PER_THREAD))
+	                         : std::max<size_t>(1, itemCount);
+}
+
+void extractMainShapeAttributes(const AttributeMapSPtr& convertShapeAttr, int32_t& seed, std::wstring& shapeName) {
 	if (convertShapeAttr) {
 		if (convertShapeAttr->hasKey(L"seed") && convertShapeAttr->getType(L"seed") == prt::AttributeMap::PT_INT)
 			seed = convertShapeAttr->getInt(L"seed");
@@ -49,143 +98,285 @@ void extractMainShapeAttributes(const py::dict& shapeAttr, int32_t& seed, std::w
 
 } // namespace
 
-ModelGenerator::ModelGenerator(const std::vector<InitialShape>& myGeo) {
-	mInitialShapesBuilders.resize(myGeo.size());
-
-	mCache = (CachePtr)prt::CacheObject::create(prt::CacheObject::CACHE_TYPE_DEFAULT);
+/**
+ * Throws if the file encoders specify different output paths, the file encoders of a generate call share one file
+ * output.
+ */
+void validateGeometryEncoders(const GeometryEncoders& geometryEncoders) {
+	std::optional<std::filesystem::path> outputPath;
+	for (const GeometryEncoder& encoder : geometryEncoders) {
+		if (encoder.mName == ENCODER_ID_PYTHON || !encoder.mOptions.contains(ENC_OPT_OUTPUT_PATH))
+			continue;
+
+		const std::filesystem::path path =
+		        std::filesystem::path(encoder.mOptions[ENC_OPT_OUTPUT_PATH].cast<std::string>()).lexically_normal();
+		if (!outputPath)
+			outputPath = path;
+		else if (path != *outputPath)
+			throw std::invalid_argument("all geometry encoders must use the same '" +
+			                            std::string(ENC_OPT_OUTPUT_PATH) + "', got " + outputPath->string() +
+			                            " and " + path.string() + ".");
+	}
+}
 
-	// Initial shapes initializing
-	for (size_t ind = 0; ind < myGeo.size(); ind++) {
+// only the PyEncoder returns generated models, file encoders alone always return an empty list
+bool hasPyEncoder(const GeometryEncoders& geometryEncoders) {
+	return std::any_of(geometryEncoders.begin(), geometryEncoders.end(),
+	                   [](const GeometryEncoder& encoder) { return encoder.mName == ENCODER_ID_PYTHON; });
+}
 
-		InitialShapeBuilderPtr isb{prt::InitialShapeBuilder::create()};
+ModelGenerator::ModelGenerator(const std::vector<InitialShape>& myGeo, size_t numThreads) {
+	mCache = CachePool::get().getCache();
 
+	// Initial shapes initializing
+	auto setGeometry = [&myGeo, this](size_t ind, prt::InitialShapeBuilder& isb) {
 		if (myGeo[ind].getPathFlag()) {
+			// decoded geometry is shared by all generators, files with texture coordinates or materials go through PRT
+			const GeometryCache::GeometryPtr geometry = GeometryCache::get().getGeometry(myGeo[ind].getPath(), false);
+			if (geometry && !geometry->mHasAppearance) {
+				const InitialShapeBatch::Shape shape = geometry->mShapes.getShape(0);
+				if (isb.setGeometry(shape.mVertices, shape.mVertexCoordsCount, shape.mIndices, shape.mIndexCount,
+				                    shape.mFaceCounts, shape.mFaceCountsCount, shape.mHoles,
+				                    shape.mHolesCount) == prt::STATUS_OK)
+					return true;
+			}
+
 			if (!pcu::toFileURI(myGeo[ind].getPath()).empty()) {
 				LOG_DBG << "trying to read initial shape geometry from " << pcu::toFileURI(myGeo[ind].getPath())
 				        << std::endl;
 				const prt::Status s =
-				        isb->resolveGeometry(pcu::toUTF16FromOSNarrow(pcu::toFileURI(myGeo[ind].getPath())).c_str(),
-				                             mResolveMap.get(), mCache.get());
+				        isb.resolveGeometry(pcu::toUTF16FromOSNarrow(pcu::toFileURI(myGeo[ind].getPath())).c_str(),
+				                            nullptr, mCache.get());
 				if (s != prt::STATUS_OK) {
 					LOG_ERR << "could not resolve geometry from " << pcu::toFileURI(myGeo[ind].getPath());
-					mValid = false;
+					return false;
 				}
+
+				std::error_code ec;
+				const uintmax_t size = std::filesystem::file_size(myGeo[ind].getPath(), ec);
+				CachePool::get().track(pcu::toUTF16FromOSNarrow(pcu::toFileURI(myGeo[ind].getPath())), ec ? 0 : size);
+				return true;
 			}
-			else {
-				LOG_ERR << "could not read initial shape geometry, invalid path";
-				mValid = false;
-			}
+
+			LOG_ERR << "could not read initial shape geometry, invalid path";
+			return false;
 		}
-		else {
-			if (isb->setGeometry(myGeo[ind].getVertices(), myGeo[ind].getVertexCount(), myGeo[ind].getIndices(),
-			                     myGeo[ind].getIndexCount(), myGeo[ind].getFaceCounts(),
-			                     myGeo[ind].getFaceCountsCount(), myGeo[ind].getHoles(),
-			                     myGeo[ind].getHolesCount()) != prt::STATUS_OK) {
 
-				LOG_ERR << "invalid initial geometry";
-				mValid = false;
-			}
+		if (isb.setGeometry(myGeo[ind].getVertices(), myGeo[ind].getVertexCount(), myGeo[ind].getIndices(),
+		                    myGeo[ind].getIndexCount(), myGeo[ind].getFaceCounts(), myGeo[ind].getFaceCountsCount(),
+		                    myGeo[ind].getHoles(), myGeo[ind].getHolesCount()) != prt::STATUS_OK) {
+			LOG_ERR << "invalid initial geometry";
+			return false;
 		}
+		return true;
+	};
+	initializeInitialShapeBuilders(myGeo.size(), numThreads, setGeometry);
+}
 
-		if (mValid)
-			mInitialShapesBuilders[ind] = std::move(isb);
-	}
+ModelGenerator::ModelGenerator(const InitialShapeBatch& initialShapes, size_t numThreads) {
+	mCache = CachePool::get().getCache();
+
+	// the builders copy the geometry, the batch does not need to outlive the generator
+	auto setGeometry = [&initialShapes](size_t ind, prt::InitialShapeBuilder& isb) {
+		const InitialShapeBatch::Shape shape = initialShapes.getShape(ind);
+		if (isb.setGeometry(shape.mVertices, shape.mVertexCoordsCount, shape.mIndices, shape.mIndexCount,
+		                    shape.mFaceCounts, shape.mFaceCountsCount, shape.mHoles,
+		                    shape.mHolesCount) != prt::STATUS_OK) {
+			LOG_ERR << "invalid initial geometry at index " << ind;
+			return false;
+		}
+		return true;
+	};
+	initializeInitialShapeBuilders(initialShapes.size(), numThreads, setGeometry);
 }
 
-void ModelGenerator::setAndCreateInitialShape(const std::vector<py::dict>& shapesAttr,
+/**
+ * Creates one builder per initial shape on several threads with the GIL released, setGeometry must not touch Python
+ * objects. Each builder is stored at the index of its initial shape, the generator is invalid if any setup fails.
+ */
+void ModelGenerator::initializeInitialShapeBuilders(size_t shapeCount, size_t numThreads,
+                                                    const SetGeometryFunc& setGeometry) {
+	mInitialShapesBuilders.resize(shapeCount);
+
+	const size_t threadCount = std::min(pcu::getThreadCount(numThreads), std::max<size_t>(shapeCount, 1));
+	const size_t unitSize = getWorkUnitSize(shapeCount, threadCount);
+	const size_t unitCount = (shapeCount + unitSize - 1) / unitSize;
+
+	std::atomic<bool> valid(true);
+	py::gil_scoped_release release;
+	pcu::parallelFor(unitCount, threadCount, [&](size_t unit) {
+		const size_t last = std::min(shapeCount, (unit + 1) * unitSize);
+		for (size_t ind = unit * unitSize; ind < last; ind++) {
+			InitialShapeBuilderPtr isb{prt::InitialShapeBuilder::create()};
+			if (setGeometry(ind, *isb))
+				mInitialShapesBuilders[ind] = std::move(isb);
+			else
+				valid = false;
+		}
+	});
+	mValid = valid;
+}
+
+size_t ModelGenerator::getInitialShapeCount() const {
+	return mInitialShapesBuilders.size();
+}
+
+/**
+ * Dict shape attributes need the GIL and are converted up front, mostly from the attribute map cache. Columnar shape
+ * attributes are converted on the worker threads together with the creation of the initial shapes, the initial shape
+ * order is kept.
+ */
+void ModelGenerator::setAndCreateInitialShape(const ShapeAttributes& shapesAttr, const RuleInfo& ruleInfo,
+                                              const prt::ResolveMap* resolveMap, size_t firstShape, size_t numThreads,
                                               std::vector<const prt::InitialShape*>& initShapes,
                                               std::vector<InitialShapePtr>& initShapePtrs,
-                                              std::vector<AttributeMapPtr>& convertedShapeAttr) {
-	for (size_t ind = 0; ind < mInitialShapesBuilders.size(); ind++) {
-		py::dict shapeAttr = shapesAttr[0];
-		if (shapesAttr.size() > ind)
-			shapeAttr = shapesAttr[ind];
+                                              std::vector<AttributeMapSPtr>& convertedShapeAttr) {
+	const size_t shapeCount = initShapes.size();
+
+	if (!shapesAttr.isColumnar()) {
+		const AttributeMapBuilderPtr attributeBuilder{prt::AttributeMapBuilder::create()};
+		for (size_t ind = 0; ind < shapeCount; ind++) {
+			// a broadcast dict is converted once
+			convertedShapeAttr[ind] = (ind > 0 && shapesAttr.isBroadcast())
+			                                  ? convertedShapeAttr[0]
+			                                  : shapesAttr.getAttributeMap(firstShape + ind, *attributeBuilder);
+		}
+	}
 
-		int32_t randomS = mSeed;
-		std::wstring shapeN = mShapeName;
-		extractMainShapeAttributes(shapeAttr, randomS, shapeN, convertedShapeAttr[ind]);
+	const size_t threadCount = std::min(pcu::getThreadCount(numThreads), std::max<size_t>(shapeCount, 1));
+	const size_t unitSize = getWorkUnitSize(shapeCount, threadCount);
+	const size_t unitCount = (shapeCount + unitSize - 1) / unitSize;
+
+	auto createUnit = [&](size_t unit) {
+		const AttributeMapBuilderPtr attributeBuilder{prt::AttributeMapBuilder::create()};
+		const size_t last = std::min(shapeCount, (unit + 1) * unitSize);
+		for (size_t ind = unit * unitSize; ind < last; ind++) {
+			const size_t shapeIndex = firstShape + ind;
+			if (shapesAttr.isColumnar())
+				convertedShapeAttr[ind] = shapesAttr.getAttributeMap(shapeIndex, *attributeBuilder);
+
+			int32_t randomS = mSeed;
+			std::wstring shapeN = mShapeName;
+			extractMainShapeAttributes(convertedShapeAttr[ind], randomS, shapeN);
+
+			// the builders are shared by concurrent calls, the created initial shape keeps its own copy of the
+			// attributes
+			std::lock_guard<std::mutex> lock(
+			        mInitialShapesBuildersMutexes[shapeIndex % mInitialShapesBuildersMutexes.size()]);
+			InitialShapeBuilderPtr& builder = mInitialShapesBuilders[shapeIndex];
+			builder->setAttributes(ruleInfo.getRuleFile().c_str(), ruleInfo.getStartRule().c_str(), randomS,
+			                       shapeN.c_str(), convertedShapeAttr[ind].get(), resolveMap);
+
+			initShapePtrs[ind].reset(builder->createInitialShape());
+			initShapes[ind] = initShapePtrs[ind].get();
+		}
+	};
+
+	py::gil_scoped_release release;
+	pcu::parallelFor(unitCount, threadCount, createUnit);
+}
 
-		mInitialShapesBuilders[ind]->setAttributes(mRuleFile.c_str(), mStartRule.c_str(), randomS, shapeN.c_str(),
-		                                           convertedShapeAttr[ind].get(), mResolveMap.get());
+/**
+ * Adds the geometry encoders followed by the auxiliary encoders. An auxiliary encoder is left out if none of the
+ * geometry encoders needs it.
+ */
+void ModelGenerator::initializeEncoderData(const GeometryEncoders& geometryEncoders,
+                                           std::vector<std::wstring>& encodersNames,
+                                           std::vector<AttributeMapSPtr>& encodersOptions) const {
+	encodersNames.clear();
+	encodersOptions.clear();
+
+	EncoderOptionsCache& optionsCache = EncoderOptionsCache::get();
+	bool emitReport = false;
+	bool emitPrints = false;
+	bool emitErrors = false;
+	bool emitAttributes = false;
+	for (const GeometryEncoder& encoder : geometryEncoders) {
+		py::dict geometryEncOpt;
+		for (const auto& item : encoder.mOptions) {
+			const std::string key = py::str(item.first);
+			if (key != ENC_OPT_EMIT_ATTRIBUTES && key != ENC_OPT_EMIT_PRINTS && key != ENC_OPT_EMIT_ERRORS)
+				geometryEncOpt[item.first] = item.second;
+		}
 
-		initShapePtrs[ind].reset(mInitialShapesBuilders[ind]->createInitialShape());
-		initShapes[ind] = initShapePtrs[ind].get();
+		encodersNames.push_back(encoder.mName);
+		encodersOptions.push_back(optionsCache.getValidatedOptions(encoder.mName, geometryEncOpt));
+
+		// the PyEncoder collects its reports itself, the report encoder is left out if the PyEncoder does not emit them
+		emitReport |= (encoder.mName != ENCODER_ID_PYTHON) || getEmitOption(encoder.mOptions, ENC_OPT_EMIT_REPORT);
+		emitPrints |= getEmitOption(encoder.mOptions, ENC_OPT_EMIT_PRINTS);
+		emitErrors |= getEmitOption(encoder.mOptions, ENC_OPT_EMIT_ERRORS);
+		emitAttributes |= getEmitOption(encoder.mOptions, ENC_OPT_EMIT_ATTRIBUTES);
 	}
-}
 
-void ModelGenerator::initializeEncoderData(const std::wstring& encName, const py::dict& encOpt) {
-	mEncodersNames.clear();
-	mEncodersOptionsPtr.clear();
-
-	mEncodersNames.push_back(encName);
-	const AttributeMapPtr encOptions{pcu::createAttributeMapFromPythonDict(encOpt, *mEncoderBuilder)};
-	mEncodersOptionsPtr.push_back(pcu::createValidatedOptions(encName.c_str(), encOptions));
-
-	mEncodersNames.push_back(ENCODER_ID_CGA_REPORT);
-	mEncodersNames.push_back(ENCODER_ID_CGA_PRINT);
-	mEncodersNames.push_back(ENCODER_ID_CGA_ERROR);
-	mEncodersNames.push_back(ENCODER_ID_ATTR_EVAL);
-
-	const AttributeMapBuilderPtr optionsBuilder{prt::AttributeMapBuilder::create()};
-	const AttributeMapPtr reportOptions{optionsBuilder->createAttributeMapAndReset()};
-	const AttributeMapPtr printOptions{optionsBuilder->createAttributeMapAndReset()};
-	const AttributeMapPtr errorOptions{optionsBuilder->createAttributeMapAndReset()};
-	const AttributeMapPtr attrOptions{optionsBuilder->createAttributeMapAndReset()};
-
-	mEncodersOptionsPtr.push_back(pcu::createValidatedOptions(ENCODER_ID_CGA_REPORT, reportOptions));
-	mEncodersOptionsPtr.push_back(pcu::createValidatedOptions(ENCODER_ID_CGA_PRINT, printOptions));
-	mEncodersOptionsPtr.push_back(pcu::createValidatedOptions(ENCODER_ID_CGA_ERROR, errorOptions));
-	mEncodersOptionsPtr.push_back(pcu::createValidatedOptions(ENCODER_ID_ATTR_EVAL, attrOptions));
+	auto addEncoder = [&](const std::wstring& encoderName) {
+		encodersNames.push_back(encoderName);
+		encodersOptions.push_back(optionsCache.getValidatedOptions(encoderName, py::dict()));
+	};
+	if (emitReport)
+		addEncoder(ENCODER_ID_CGA_REPORT);
+	if (emitPrints)
+		addEncoder(ENCODER_ID_CGA_PRINT);
+	if (emitErrors)
+		addEncoder(ENCODER_ID_CGA_ERROR);
+	if (emitAttributes)
+		addEncoder(ENCODER_ID_ATTR_EVAL);
 }
 
 prt::Status ModelGenerator::initializeRulePackageData(const std::filesystem::path& rulePackagePath,
-                                                      ResolveMapPtr& resolveMap, CachePtr& cache) {
+                                                      RuleInfoPtr& ruleInfo, ResolveMapSPtr& resolveMap) const {
 	if (!std::filesystem::exists(rulePackagePath)) {
 		LOG_ERR << "The rule package path is unvalid.";
 		return prt::STATUS_FILE_NOT_FOUND;
 	}
 
-	if (!pcu::getResolveMap(rulePackagePath, &resolveMap))
+	ruleInfo = RulePackageCache::get().getRuleInfo(rulePackagePath, &resolveMap);
+	if (!resolveMap)
 		return prt::STATUS_RESOLVEMAP_PROVIDER_NOT_FOUND;
-
-	mRuleFile = pcu::getRuleFileEntry(resolveMap.get());
-
-	const wchar_t* ruleFileURI = resolveMap->getString(mRuleFile.c_str());
-	if (ruleFileURI == nullptr) {
-		LOG_ERR << "could not find rule file URI in resolve map of rule package " << rulePackagePath;
+	if (!ruleInfo)
 		return prt::STATUS_INVALID_URI;
-	}
 
-	prt::Status infoStatus = prt::STATUS_UNSPECIFIED_ERROR;
-	RuleFileInfoUPtr info(prt::createRuleFileInfo(ruleFileURI, cache.get(), &infoStatus));
-	if (!info || infoStatus != prt::STATUS_OK) {
-		LOG_ERR << "could not get rule file info from rule file " << mRuleFile;
-		return infoStatus;
-	}
-
-	mStartRule = pcu::detectStartRule(info);
-	mHiddenAttrs = pcu::getHiddenAttributes(info);
 	return prt::STATUS_OK;
 }
 
-std::vector<GeneratedModel> ModelGenerator::generateModel(const std::vector<py::dict>& shapeAttributes,
+std::vector<GeneratedModel> ModelGenerator::generateModel(const ShapeAttributes& shapeAttributes,
                                                           const std::filesystem::path& rulePackagePath,
-                                                          const std::wstring& geometryEncoderName,
-                                                          const py::dict& geometryEncoderOptions) {
+                                                          const GeometryEncoders& geometryEncoders, size_t numThreads) {
+	return generateModelBatch(shapeAttributes, rulePackagePath, geometryEncoders, numThreads, 0,
+	                          mInitialShapesBuilders.size());
+}
+
+/**
+ * Generates the initial shapes [firstShape, firstShape + shapeCount), the returned models keep the index of their
+ * initial shape in the whole generator.
+ */
+std::vector<GeneratedModel> ModelGenerator::generateModelBatch(const ShapeAttributes& shapeAttributes,
+                                                               const std::filesystem::path& rulePackagePath,
+                                                               const GeometryEncoders& geometryEncoders,
+                                                               size_t numThreads, size_t firstShape,
+                                                               size_t shapeCount) {
 	if (!mValid) {
 		LOG_ERR << "invalid ModelGenerator instance.";
 		return {};
 	}
 
-	if ((shapeAttributes.size() != 1) &&
-	    (shapeAttributes.size() <
-	     mInitialShapesBuilders.size())) { // if one shape attribute dictionary, same apply to all initial shapes.
-		LOG_ERR << "not enough shape attributes dictionaries defined.";
-		return {};
+	// columnar shape attributes are checked against the initial shape count on conversion
+	if (!shapeAttributes.isColumnar()) {
+		const size_t dictCount = shapeAttributes.getDictCount();
+		if ((dictCount != 1) &&
+		    (dictCount < mInitialShapesBuilders.size())) { // if one shape attribute dictionary, same apply to all
+			LOG_ERR << "not enough shape attributes dictionaries defined.";
+			return {};
+		}
+		else if (dictCount > mInitialShapesBuilders.size()) {
+			LOG_WRN << "number of shape attributes dictionaries defined greater than number of initial shapes given."
+			        << std::endl;
+		}
 	}
-	else if (shapeAttributes.size() > mInitialShapesBuilders.size()) {
-		LOG_WRN << "number of shape attributes dictionaries defined greater than number of initial shapes given."
-		        << std::endl;
+
+	if (firstShape > mInitialShapesBuilders.size() || shapeCount > mInitialShapesBuilders.size() - firstShape) {
+		LOG_ERR << "initial shape range is out of bounds.";
+		return {};
 	}
 
 	try {
@@ -195,79 +386,100 @@ std::vector<GeneratedModel> ModelGenerator::generateModel(const std::vector<py::
 		}
 
 		// Rule package
-		prt::Status rpkStat = initializeRulePackageData(rulePackagePath, mResolveMap, mCache);
+		RuleInfoPtr ruleInfo;
+		ResolveMapSPtr resolveMap;
+		prt::Status rpkStat = prt::STATUS_UNSPECIFIED_ERROR;
+		{
+			// hashing, unpacking or waiting for another process to unpack the rule package only touches native state
+			py::gil_scoped_release release;
+			rpkStat = initializeRulePackageData(rulePackagePath, ruleInfo, resolveMap);
+		}
 
 		if (rpkStat != prt::STATUS_OK)
 			return {};
 
 		// Initial shapes
-		std::vector<const prt::InitialShape*> initialShapes(mInitialShapesBuilders.size());
-		std::vector<InitialShapePtr> initialShapePtrs(mInitialShapesBuilders.size());
-		std::vector<AttributeMapPtr> convertedShapeAttrVec(mInitialShapesBuilders.size());
-		setAndCreateInitialShape(shapeAttributes, initialShapes, initialShapePtrs, convertedShapeAttrVec);
+		std::vector<const prt::InitialShape*> initialShapes(shapeCount);
+		std::vector<InitialShapePtr> initialShapePtrs(shapeCount);
+		std::vector<AttributeMapSPtr> convertedShapeAttrVec(shapeCount);
+		setAndCreateInitialShape(shapeAttributes, *ruleInfo, resolveMap.get(), firstShape, numThreads, initialShapes,
+		                         initialShapePtrs, convertedShapeAttrVec);
 
 		// Encoder info, encoder options
-		if (!mEncoderBuilder)
-			mEncoderBuilder.reset(prt::AttributeMapBuilder::create());
+		std::vector<std::wstring> encodersNames;
+		std::vector<AttributeMapSPtr> encodersOptionsPtr;
+		initializeEncoderData(geometryEncoders, encodersNames, encodersOptionsPtr);
 
-		initializeEncoderData(geometryEncoderName, geometryEncoderOptions);
-
-		assert(mEncodersNames.size() == mEncodersOptionsPtr.size());
-		const std::vector<const wchar_t*> encoders = pcu::toPtrVec(mEncodersNames);
-		const std::vector<const prt::AttributeMap*> encodersOptions = pcu::toPtrVec(mEncodersOptionsPtr);
+		assert(encodersNames.size() == encodersOptionsPtr.size());
+		const std::vector<const wchar_t*> encoders = pcu::toPtrVec(encodersNames);
+		const std::vector<const prt::AttributeMap*> encodersOptions = pcu::toPtrVec(encodersOptionsPtr);
 		assert(encoders.size() == encodersOptions.size());
 
-		if (geometryEncoderName == ENCODER_ID_PYTHON) {
+		const bool hasFileEncoder =
+		        std::any_of(geometryEncoders.begin(), geometryEncoders.end(),
+		                    [](const GeometryEncoder& encoder) { return encoder.mName != ENCODER_ID_PYTHON; });
 
-			PyCallbacksPtr foc{std::make_unique<PyCallbacks>(mInitialShapesBuilders.size(), mHiddenAttrs)};
+		FileOutputCallbacksPtr foc;
+		if (hasFileEncoder) {
+			foc = createFileOutputCallbacks(geometryEncoders);
+			if (!foc)
+				return {};
+		}
 
-			// Generate
-			const prt::Status genStat =
-			        prt::generate(initialShapes.data(), initialShapes.size(), nullptr, encoders.data(), encoders.size(),
-			                      encodersOptions.data(), foc.get(), mCache.get(), nullptr);
+		if (hasPyEncoder(geometryEncoders)) {
+
+			// The initial shapes are split into work units, each generated with its own callbacks by the next idle
+			// thread. The payloads are merged back in initial shape order. File encoders in the same call get all
+			// initial shapes in one unit, otherwise each unit would overwrite their files.
+			const size_t threadCount =
+			        foc ? 1 : std::min(pcu::getThreadCount(numThreads), std::max<size_t>(shapeCount, 1));
+			const size_t unitSize = getWorkUnitSize(shapeCount, threadCount);
+			const size_t unitCount = (shapeCount + unitSize - 1) / unitSize;
+
+			std::vector<GeneratedPayloadPtr> payloads(shapeCount);
+			std::vector<prt::Status> unitStatus(unitCount, prt::STATUS_OK);
+			auto generateUnit = [&](size_t unit) {
+				const size_t first = unit * unitSize;
+				const size_t count = std::min(unitSize, shapeCount - first);
+
+				PyCallbacksPtr pyCallbacks{
+				        std::make_unique<PyCallbacks>(count, ruleInfo->getHiddenAttributes(), foc.get())};
+				unitStatus[unit] =
+				        prt::generate(initialShapes.data() + first, count, nullptr, encoders.data(), encoders.size(),
+				                      encodersOptions.data(), pyCallbacks.get(), mCache.get(), nullptr);
+				for (size_t idx = 0; idx < count; idx++)
+					payloads[first + idx] = pyCallbacks->getGeneratedPayload(idx);
+			};
+
+			// Generate, the callbacks only touch native buffers so other Python threads can run meanwhile
+			{
+				py::gil_scoped_release release;
+				pcu::parallelFor(unitCount, threadCount, generateUnit);
+			}
 
-			if (genStat != prt::STATUS_OK) {
-				LOG_ERR << "prt::generate() failed with status: '" << prt::getStatusDescription(genStat) << "' ("
-				        << genStat << ")";
-				return {};
+			for (const prt::Status genStat : unitStatus) {
+				if (genStat != prt::STATUS_OK) {
+					LOG_ERR << "prt::generate() failed with status: '" << prt::getStatusDescription(genStat) << "' ("
+					        << genStat << ")";
+					return {};
+				}
 			}
 
 			std::vector<GeneratedModel> newGeneratedGeo;
-			newGeneratedGeo.reserve(mInitialShapesBuilders.size());
-			for (size_t idx = 0; idx < mInitialShapesBuilders.size(); idx++) {
-				newGeneratedGeo.emplace_back(idx, foc->getGeneratedPayload(idx));
+			newGeneratedGeo.reserve(shapeCount);
+			for (size_t idx = 0; idx < shapeCount; idx++) {
+				newGeneratedGeo.emplace_back(firstShape + idx, payloads[idx]);
 			}
 			return newGeneratedGeo;
 		}
 		else {
-			const std::filesystem::path outputPath = [&geometryEncoderOptions]() {
-				if (geometryEncoderOptions.contains(ENC_OPT_OUTPUT_PATH)) {
-					return std::filesystem::path(geometryEncoderOptions[ENC_OPT_OUTPUT_PATH].cast<std::string>());
-				}
-				else {
-					const auto fallbackOutputPath = std::filesystem::temp_directory_path() / "pyprt_fallback_output";
-					std::filesystem::create_directory(fallbackOutputPath);
-					LOG_WRN << "Encoder option '" << ENC_OPT_OUTPUT_PATH
-					        << "' was not specified, falling back to system tmp directory:" << fallbackOutputPath;
-					return fallbackOutputPath;
-				}
-			}();
-			LOG_DBG << "got outputPath = " << outputPath;
-
-			FileOutputCallbacksPtr foc;
-			if (std::filesystem::is_directory(outputPath) && std::filesystem::exists(outputPath)) {
-				foc.reset(prt::FileOutputCallbacks::create(outputPath.wstring().c_str()));
-			}
-			else {
-				LOG_ERR << "The directory specified by '" << ENC_OPT_OUTPUT_PATH
-				        << "' is not valid or does not exist: " << outputPath << std::endl;
-				return {};
-			}
-
 			// Generate
-			const prt::Status genStat =
-			        prt::generate(initialShapes.data(), initialShapes.size(), nullptr, encoders.data(), encoders.size(),
-			                      encodersOptions.data(), foc.get(), mCache.get(), nullptr);
+			prt::Status genStat = prt::STATUS_UNSPECIFIED_ERROR;
+			{
+				py::gil_scoped_release release;
+				genStat = prt::generate(initialShapes.data(), initialShapes.size(), nullptr, encoders.data(),
+				                        encoders.size(), encodersOptions.data(), foc.get(), mCache.get(), nullptr);
+			}
 
 			if (genStat != prt::STATUS_OK) {
 				LOG_ERR << "prt::generate() failed with status: '" << prt::getStatusDescription(genStat) << "' ("
@@ -21,46 +21,69 @@
 
 #include "GeneratedModel.h"
 #include "InitialShape.h"
+#include "InitialShapeBatch.h"
+#include "RuleInfo.h"
+#include "ShapeAttributes.h"
 #include "types.h"
 #include "utils.h"
 
 #include "pybind11/pybind11.h"
 
+#include <array>
 #include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
 #include <vector>
 
+// a geometry encoder ID and its options (not validated yet)
+struct GeometryEncoder {
+	std::wstring mName;
+	pybind11::dict mOptions;
+};
+using GeometryEncoders = std::vector<GeometryEncoder>;
+
+void validateGeometryEncoders(const GeometryEncoders& geometryEncoders);
+bool hasPyEncoder(const GeometryEncoders& geometryEncoders);
+
 class ModelGenerator {
 public:
-	ModelGenerator(const std::vector<InitialShape>& myGeo);
+	ModelGenerator(const std::vector<InitialShape>& myGeo, size_t numThreads = 0);
+	ModelGenerator(const InitialShapeBatch& initialShapes, size_t numThreads = 0);
 	~ModelGenerator() = default;
 
-	std::vector<GeneratedModel> generateModel(const std::vector<pybind11::dict>& shapeAttributes,
+	std::vector<GeneratedModel> generateModel(const ShapeAttributes& shapeAttributes,
 	                                          const std::filesystem::path& rulePackagePath,
-	                                          const std::wstring& geometryEncoderName,
-	                                          const pybind11::dict& geometryEcoderOptions);
+	                                          const GeometryEncoders& geometryEncoders, size_t numThreads = 1);
+	std::vector<GeneratedModel> generateModelBatch(const ShapeAttributes& shapeAttributes,
+	                                               const std::filesystem::path& rulePackagePath,
+	                                               const GeometryEncoders& geometryEncoders, size_t numThreads,
+	                                               size_t firstShape, size_t shapeCount);
+
+	size_t getInitialShapeCount() const;
 
 private:
-	ResolveMapPtr mResolveMap;
-	CachePtr mCache;
+	// all state set up per generateModel call is kept local to the call, concurrent calls only share the members below
+	CacheSPtr mCache;
 
-	AttributeMapBuilderPtr mEncoderBuilder;
-	std::vector<AttributeMapPtr> mEncodersOptionsPtr;
-	std::vector<std::wstring> mEncodersNames;
 	std::vector<InitialShapeBuilderPtr> mInitialShapesBuilders;
+	// guard setting the attributes and creating the initial shapes, striped by initial shape index
+	std::array<std::mutex, 64> mInitialShapesBuildersMutexes;
 
-	std::wstring mRuleFile;
-	std::wstring mStartRule;
-	std::unordered_set<std::wstring> mHiddenAttrs;
-	int32_t mSeed = 0;
-	std::wstring mShapeName = L"InitialShape";
+	const int32_t mSeed = 0;
+	const std::wstring mShapeName = L"InitialShape";
 
 	bool mValid = true;
 
-	void setAndCreateInitialShape(const std::vector<pybind11::dict>& shapeAttr,
+	using SetGeometryFunc = std::function<bool(size_t shapeIndex, prt::InitialShapeBuilder& builder)>;
+	void initializeInitialShapeBuilders(size_t shapeCount, size_t numThreads, const SetGeometryFunc& setGeometry);
+	void setAndCreateInitialShape(const ShapeAttributes& shapeAttr, const RuleInfo& ruleInfo,
+	                              const prt::ResolveMap* resolveMap, size_t firstShape, size_t numThreads,
 	                              std::vector<const prt::InitialShape*>& initShapes,
 	                              std::vector<InitialShapePtr>& initShapesPtrs,
-	                              std::vector<AttributeMapPtr>& convertShapeAttr);
-	void initializeEncoderData(const std::wstring& encName, const pybind11::dict& encOpt);
-	prt::Status initializeRulePackageData(const std::filesystem::path& rulePackagePath, ResolveMapPtr& resolveMap,
-	                                      CachePtr& cache);
+	                              std::vector<AttributeMapSPtr>& convertShapeAttr);
+	void initializeEncoderData(const GeometryEncoders& geometryEncoders, std::vector<std::wstring>& encodersNames,
+	                           std::vector<AttributeMapSPtr>& encodersOptions) const;
+	prt::Status initializeRulePackageData(const std::filesystem::path& rulePackagePath, RuleInfoPtr& ruleInfo,
+	                                      ResolveMapSPtr& resolveMap) const;
 };
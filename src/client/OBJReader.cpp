@@ -0,0 +1,186 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#include "OBJReader.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool isSpace(char c) {
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+const char* skipSpaces(const char* p, const char* end) {
+	while (p < end && isSpace(*p))
+		p++;
+	return p;
+}
+
+const char* skipToken(const char* p, const char* end) {
+	while (p < end && !isSpace(*p))
+		p++;
+	return p;
+}
+
+bool isKeyword(const char* p, const char* end, const char* keyword) {
+	for (; *keyword != '\0'; p++, keyword++) {
+		if (p == end || *p != *keyword)
+			return false;
+	}
+	return p == end || isSpace(*p);
+}
+
+// the content is not null-terminated per line, copy the token to parse it
+double parseDouble(const char* first, const char* last, size_t lineNumber) {
+	const std::string token(first, last);
+	char* parsedEnd = nullptr;
+	const double value = std::strtod(token.c_str(), &parsedEnd);
+	if (token.empty() || parsedEnd != token.c_str() + token.size())
+		throw std::invalid_argument("invalid vertex coordinate in line " + std::to_string(lineNumber) + ".");
+	return value;
+}
+
+// OBJ indices are one-based, negative ones are relative to the last vertex read so far
+uint32_t parseVertexIndex(const char* first, const char* last, size_t vertexCount, size_t lineNumber) {
+	const std::string token(first, last);
+	char* parsedEnd = nullptr;
+	const long long index = std::strtoll(token.c_str(), &parsedEnd, 10);
+	if (token.empty() || parsedEnd == token.c_str() || (*parsedEnd != '\0' && *parsedEnd != '/'))
+		throw std::invalid_argument("invalid face index in line " + std::to_string(lineNumber) + ".");
+
+	const long long resolved = (index < 0) ? static_cast<long long>(vertexCount) + index : index - 1;
+	if (index == 0 || resolved < 0 || resolved >= static_cast<long long>(std::numeric_limits<uint32_t>::max()))
+		throw std::invalid_argument("face index out of range in line " + std::to_string(lineNumber) + ".");
+	return static_cast<uint32_t>(resolved);
+}
+
+} // namespace
+
+/**
+ * Faces may refer to vertices defined later in the file, the indices are checked once all vertices are read. Objects
+ * without faces are skipped. In split mode each shape only keeps the vertices its faces use.
+ */
+OBJReader::Result OBJReader::read(const std::string& content, bool splitObjects) {
+	Coordinates vertices;
+	Indices faceIndices; // global vertex indices
+	Indices faceCounts;
+	std::vector<size_t> objectFaceOffsets{0};
+	bool hasAppearance = false;
+
+	const char* p = content.data();
+	const char* const end = p + content.size();
+	for (size_t lineNumber = 1; p < end; lineNumber++) {
+		const char* lineEnd = p;
+		while (lineEnd < end && *lineEnd != '\n')
+			lineEnd++;
+
+		const char* token = skipSpaces(p, lineEnd);
+		if (isKeyword(token, lineEnd, "v")) {
+			const char* c = token + 1;
+			for (int i = 0; i < 3; i++) {
+				c = skipSpaces(c, lineEnd);
+				const char* tokenEnd = skipToken(c, lineEnd);
+				vertices.push_back(parseDouble(c, tokenEnd, lineNumber));
+				c = tokenEnd;
+			}
+		}
+		else if (isKeyword(token, lineEnd, "f")) {
+			uint32_t count = 0;
+			for (const char* c = skipSpaces(token + 1, lineEnd); c < lineEnd; c = skipSpaces(c, lineEnd)) {
+				const char* tokenEnd = skipToken(c, lineEnd);
+				faceIndices.push_back(parseVertexIndex(c, tokenEnd, vertices.size() / 3, lineNumber));
+				count++;
+				c = tokenEnd;
+			}
+			if (count < 3)
+				throw std::invalid_argument("face with less than 3 vertices in line " + std::to_string(lineNumber) +
+				                            ".");
+			faceCounts.push_back(count);
+		}
+		else if (isKeyword(token, lineEnd, "o") || isKeyword(token, lineEnd, "g")) {
+			if (splitObjects && faceCounts.size() > objectFaceOffsets.back())
+				objectFaceOffsets.push_back(faceCounts.size());
+		}
+		else if (isKeyword(token, lineEnd, "vt") || isKeyword(token, lineEnd, "usemtl") ||
+		         isKeyword(token, lineEnd, "mtllib")) {
+			hasAppearance = true;
+		}
+
+		p = (lineEnd < end) ? lineEnd + 1 : end;
+	}
+	if (faceCounts.size() > objectFaceOffsets.back())
+		objectFaceOffsets.push_back(faceCounts.size());
+
+	if (faceCounts.empty())
+		throw std::invalid_argument("the OBJ file has no faces.");
+
+	const size_t vertexCount = vertices.size() / 3;
+	for (const uint32_t index : faceIndices) {
+		if (index >= vertexCount)
+			throw std::invalid_argument("face index " + std::to_string(index + 1) + " is out of range.");
+	}
+
+	InitialShapeBatch::Buffers buffers;
+	if (!splitObjects) {
+		buffers.mVertexOffsets = {0, vertexCount};
+		buffers.mIndexOffsets = {0, faceIndices.size()};
+		buffers.mFaceCountOffsets = {0, faceCounts.size()};
+		buffers.mVertices = std::move(vertices);
+		buffers.mIndices = std::move(faceIndices);
+		buffers.mFaceCounts = std::move(faceCounts);
+		return {InitialShapeBatch(std::move(buffers)), hasAppearance};
+	}
+
+	// remap the global vertex indices to the vertices used by each object, localObject marks the valid local indices
+	const size_t objectCount = objectFaceOffsets.size() - 1;
+	std::vector<uint32_t> localIndex(vertexCount);
+	std::vector<size_t> localObject(vertexCount, objectCount);
+	buffers.mIndices.reserve(faceIndices.size());
+	buffers.mVertexOffsets.push_back(0);
+	buffers.mIndexOffsets.push_back(0);
+	buffers.mFaceCountOffsets.push_back(0);
+
+	size_t index = 0;
+	for (size_t face = 0, object = 0; object < objectCount; object++) {
+		uint32_t objectVertexCount = 0;
+		for (; face < objectFaceOffsets[object + 1]; face++) {
+			for (uint32_t i = 0; i < faceCounts[face]; i++, index++) {
+				const uint32_t v = faceIndices[index];
+				if (localObject[v] != object) {
+					localObject[v] = object;
+					localIndex[v] = objectVertexCount++;
+					buffers.mVertices.insert(buffers.mVertices.end(), vertices.begin() + 3 * v,
+					                         vertices.begin() + 3 * v + 3);
+				}
+				buffers.mIndices.push_back(localIndex[v]);
+			}
+		}
+		buffers.mVertexOffsets.push_back(buffers.mVertexOffsets.back() + objectVertexCount);
+		buffers.mIndexOffsets.push_back(buffers.mIndices.size());
+		buffers.mFaceCountOffsets.push_back(objectFaceOffsets[object + 1]);
+	}
+	buffers.mFaceCounts = std::move(faceCounts);
+	return {InitialShapeBatch(std::move(buffers)), hasAppearance};
+}
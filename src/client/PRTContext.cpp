@@ -18,6 +18,10 @@
  */
 
 #include "PRTContext.h"
+#include "AttributeMapCache.h"
+#include "CachePool.h"
+#include "EncoderOptionsCache.h"
+#include "RulePackageCache.h"
 #include "utils.h"
 
 #include <array>
@@ -57,6 +61,12 @@ PRTContext::PRTContext(prt::LogLevel minimalLogLevel) {
 }
 
 PRTContext::~PRTContext() {
+	// the caches hold PRT objects and must be released while PRT is still alive
+	AttributeMapCache::get().clear();
+	EncoderOptionsCache::get().clear();
+	RulePackageCache::get().clear();
+	CachePool::get().release();
+
 	// shutdown PRT
 	mPRTHandle.reset();
 
@@ -19,11 +19,40 @@
 
 #include "PyCallbacks.h"
 
-PyCallbacks::PyCallbacks(const size_t initialShapeCount, const std::unordered_set<std::wstring>& hiddenAttrs) {
+PyCallbacks::PyCallbacks(const size_t initialShapeCount, const std::unordered_set<std::wstring>& hiddenAttrs,
+                         prt::SimpleOutputCallbacks* fileOutput)
+    : mFileOutput(fileOutput) {
 	mPayloads.resize(initialShapeCount);
 	mHiddenAttrs = hiddenAttrs;
 }
 
+uint64_t PyCallbacks::open(const wchar_t* encoderId, const prt::ContentType contentType, const wchar_t* name,
+                           prt::SimpleOutputCallbacks::StringEncoding enc,
+                           prt::SimpleOutputCallbacks::OpenMode openMode, prt::Status* stat) {
+	if (mFileOutput == nullptr) {
+		if (stat != nullptr)
+			*stat = prt::STATUS_ILLEGAL_CALLBACK_OBJECT;
+		return 0;
+	}
+	return mFileOutput->open(encoderId, contentType, name, enc, openMode, stat);
+}
+
+prt::Status PyCallbacks::write(uint64_t handle, const wchar_t* string) {
+	return mFileOutput ? mFileOutput->write(handle, string) : prt::STATUS_ILLEGAL_CALLBACK_OBJECT;
+}
+
+prt::Status PyCallbacks::write(uint64_t handle, const uint8_t* buffer, size_t size) {
+	return mFileOutput ? mFileOutput->write(handle, buffer, size) : prt::STATUS_ILLEGAL_CALLBACK_OBJECT;
+}
+
+prt::Status PyCallbacks::seek(uint64_t handle, int64_t offset, prt::SimpleOutputCallbacks::SeekOrigin origin) {
+	return mFileOutput ? mFileOutput->seek(handle, offset, origin) : prt::STATUS_ILLEGAL_CALLBACK_OBJECT;
+}
+
+prt::Status PyCallbacks::close(uint64_t handle, const size_t* isIndices, size_t isIndicesCount) {
+	return mFileOutput ? mFileOutput->close(handle, isIndices, isIndicesCount) : prt::STATUS_ILLEGAL_CALLBACK_OBJECT;
+}
+
 prt::Status PyCallbacks::generateError(size_t /*isIndex*/, prt::Status /*status*/, const wchar_t* /*message*/) {
 	return prt::STATUS_OK;
 }
@@ -113,29 +142,26 @@ void PyCallbacks::addReports(const size_t initialShapeIndex, const wchar_t** str
                              const wchar_t** stringReportValues, size_t stringReportCount,
                              const wchar_t** floatReportKeys, const double* floatReportValues, size_t floatReportCount,
                              const wchar_t** boolReportKeys, const bool* boolReportValues, size_t boolReportCount) {
-	namespace py = pybind11;
-
 	GeneratedPayload& currentModel = getOrCreate(initialShapeIndex);
+	currentModel.mCGAReport.reserve(currentModel.mCGAReport.size() + boolReportCount + floatReportCount +
+	                                stringReportCount);
 
-	for (size_t i = 0; i < boolReportCount; i++) {
-		py::object pyKey = py::cast(boolReportKeys[i]);
-		currentModel.mCGAReport[pyKey] = boolReportValues[i];
-	}
+	for (size_t i = 0; i < boolReportCount; i++)
+		currentModel.mCGAReport.emplace_back(boolReportKeys[i], boolReportValues[i]);
 
-	for (size_t i = 0; i < floatReportCount; i++) {
-		py::object pyKey = py::cast(floatReportKeys[i]);
-		currentModel.mCGAReport[pyKey] = floatReportValues[i];
-	}
+	for (size_t i = 0; i < floatReportCount; i++)
+		currentModel.mCGAReport.emplace_back(floatReportKeys[i], floatReportValues[i]);
 
-	for (size_t i = 0; i < stringReportCount; i++) {
-		py::object pyKey = py::cast(stringReportKeys[i]);
-		currentModel.mCGAReport[pyKey] = stringReportValues[i];
-	}
+	for (size_t i = 0; i < stringReportCount; i++)
+		currentModel.mCGAReport.emplace_back(stringReportKeys[i], std::wstring(stringReportValues[i]));
 }
 
 GeneratedPayloadPtr PyCallbacks::getGeneratedPayload(size_t initialShapeIndex) {
 	if (initialShapeIndex >= mPayloads.size())
 		throw std::out_of_range("initial shape index is out of range.");
+
+	// every initial shape gets a payload, also if all encoder outputs are switched off
+	getOrCreate(initialShapeIndex);
 	return mPayloads[initialShapeIndex];
 }
 
@@ -26,6 +26,7 @@
 #include "encoder/IPyCallbacks.h"
 
 #include "prt/Callbacks.h"
+#include "prt/SimpleOutputCallbacks.h"
 
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
@@ -44,7 +45,8 @@ const std::wstring ERRORLEVELS[] = {L"Error ", L"Warning ", L"Info "};
 class PyCallbacks : public IPyCallbacks {
 public:
 	PyCallbacks() = delete;
-	explicit PyCallbacks(const size_t initialShapeCount, const std::unordered_set<std::wstring>& hiddenAttrs);
+	explicit PyCallbacks(const size_t initialShapeCount, const std::unordered_set<std::wstring>& hiddenAttrs,
+	                     prt::SimpleOutputCallbacks* fileOutput = nullptr);
 	virtual ~PyCallbacks() = default;
 
 	// prt::Callbacks implementation
@@ -69,6 +71,15 @@ public:
 	prt::Status attrStringArray(size_t isIndex, int32_t /*shapeID*/, const wchar_t* key, const wchar_t* const* ptr,
 	                            size_t size, size_t nRows) override;
 
+	// prt::SimpleOutputCallbacks implementation, forwarded to the file output of other geometry encoders
+	uint64_t open(const wchar_t* encoderId, const prt::ContentType contentType, const wchar_t* name,
+	              prt::SimpleOutputCallbacks::StringEncoding enc, prt::SimpleOutputCallbacks::OpenMode openMode,
+	              prt::Status* stat) override;
+	prt::Status write(uint64_t handle, const wchar_t* string) override;
+	prt::Status write(uint64_t handle, const uint8_t* buffer, size_t size) override;
+	prt::Status seek(uint64_t handle, int64_t offset, prt::SimpleOutputCallbacks::SeekOrigin origin) override;
+	prt::Status close(uint64_t handle, const size_t* isIndices, size_t isIndicesCount) override;
+
 	// IPyCallbacks implementation
 	void addGeometry(const size_t initialShapeIndex, const double* vertexCoords, const size_t vextexCoordsCount,
 	                 const uint32_t* faceIndices, const size_t faceIndicesCount, const uint32_t* faceCounts,
@@ -84,8 +95,10 @@ public:
 	template <typename T>
 	prt::Status storeAttr(size_t isIndex, const wchar_t* key, const T value) {
 		if (!isHiddenAttribute(key)) {
-			pybind11::object pyKey = py::cast(pcu::removeDefaultStyleName(key));
-			mPayloads[isIndex]->mAttrVal[pyKey] = value;
+			GeneratedPayload::Attribute attribute;
+			attribute.mKey = pcu::removeDefaultStyleName(key);
+			attribute.mValue = toAttributeValue(value);
+			getOrCreate(isIndex).mAttrVal.push_back(std::move(attribute));
 		}
 
 		return prt::STATUS_OK;
@@ -94,37 +107,32 @@ public:
 	template <typename T>
 	prt::Status storeAttr(size_t isIndex, const wchar_t* key, const T* ptr, const size_t size, const size_t nRows) {
 		if (!isHiddenAttribute(key)) {
-			pybind11::object pyKey = py::cast(pcu::removeDefaultStyleName(key));
-			const size_t nCol = size / nRows;
-
-			if (nRows > 1) {
-				std::vector<std::vector<T>> values(nRows, std::vector<T>(nCol));
-				for (size_t i = 0; i < size; i++) {
-					const size_t j = i / nCol;
-					const size_t k = i % nCol;
-					values[j][k] = ptr[i];
-				}
-
-				mPayloads[isIndex]->mAttrVal[pyKey] = values;
-				return prt::STATUS_OK;
-			}
-			else {
-				std::vector<T> values(nCol);
-				for (size_t i = 0; i < size; i++)
-					values[i] = ptr[i];
-
-				mPayloads[isIndex]->mAttrVal[pyKey] = values;
-				return prt::STATUS_OK;
-			}
+			using V = decltype(toAttributeValue(*ptr));
+			GeneratedPayload::Attribute attribute;
+			attribute.mKey = pcu::removeDefaultStyleName(key);
+			attribute.mValue = std::vector<V>(ptr, ptr + size);
+			attribute.mRows = nRows;
+			getOrCreate(isIndex).mAttrVal.push_back(std::move(attribute));
 		}
 
 		return prt::STATUS_OK;
 	}
 
 private:
+	static bool toAttributeValue(bool value) {
+		return value;
+	}
+	static double toAttributeValue(double value) {
+		return value;
+	}
+	static std::wstring toAttributeValue(const wchar_t* value) {
+		return value;
+	}
+
 	bool isHiddenAttribute(const wchar_t* key);
 	GeneratedPayload& getOrCreate(size_t initialShapeIndex);
 
 	std::vector<GeneratedPayloadPtr> mPayloads;
 	std::unordered_set<std::wstring> mHiddenAttrs;
+	prt::SimpleOutputCallbacks* mFileOutput; // not owned, may be null
 };
@@ -24,6 +24,8 @@
 #include <sstream>
 
 void PythonLogHandler::handleLogEvent(const wchar_t* msg, prt::LogLevel /*level*/) {
+	// log events can arrive from PRT threads while the GIL is released
+	pybind11::gil_scoped_acquire acquire;
 	pybind11::print(L"[PRT]", msg);
 }
 
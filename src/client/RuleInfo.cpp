@@ -0,0 +1,261 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#include "RuleInfo.h"
+#include "logging.h"
+#include "utils.h"
+
+#include <cstdint>
+#include <cwchar>
+#include <istream>
+#include <ostream>
+
+namespace {
+
+constexpr const wchar_t* ANNOT_HIDDEN = L"@Hidden";
+constexpr const wchar_t* CGA_STYLE_DEFAULT = L"Default$";
+
+// bump the version whenever the layout of the serialized rule info changes
+constexpr uint32_t SERIAL_MAGIC = 0x49525950; // "PYRI"
+constexpr uint32_t SERIAL_VERSION = 1;
+constexpr uint32_t SERIAL_MAX_SIZE = 1u << 24; // guards against allocating huge buffers for corrupt files
+
+/**
+ * Collects the "@"-annotations of a rule attribute, returns false if the attribute is hidden.
+ */
+bool getAnnotations(const prt::RuleFileInfo::Entry* attribute, std::vector<RuleInfo::Annotation>& annotations) {
+	for (size_t f = 0; f < attribute->getNumAnnotations(); f++) {
+		const prt::Annotation* annot = attribute->getAnnotation(f);
+		if (std::wcscmp(annot->getName(), ANNOT_HIDDEN) == 0)
+			return false;
+
+		if (std::wcsncmp(annot->getName(), L"@", 1) == 0) {
+			RuleInfo::Annotation annotation;
+			annotation.mName = annot->getName();
+
+			for (size_t u = 0; u < annot->getNumArguments(); u++) {
+				const prt::AnnotationArgument* annotationArg = annot->getArgument(u);
+
+				RuleInfo::AnnotationArgument argument;
+				argument.mKey = annotationArg->getKey();
+				argument.mType = annotationArg->getType();
+				if (argument.mType == prt::AAT_STR)
+					argument.mString = annotationArg->getStr();
+				else if (argument.mType == prt::AAT_BOOL)
+					argument.mBool = annotationArg->getBool();
+				else if (argument.mType == prt::AAT_FLOAT)
+					argument.mFloat = annotationArg->getFloat();
+
+				annotation.mArguments.push_back(std::move(argument));
+			}
+
+			annotations.push_back(std::move(annotation));
+		}
+	}
+	return true;
+}
+
+/**
+ * Serialization helpers, values are written in native byte order as the files are local caches.
+ */
+template <typename T>
+void writeValue(std::ostream& out, T value) {
+	out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::istream& in, T& value) {
+	return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+bool readSize(std::istream& in, size_t& size) {
+	uint32_t value = 0;
+	if (!readValue(in, value) || value > SERIAL_MAX_SIZE)
+		return false;
+	size = value;
+	return true;
+}
+
+void writeString(std::ostream& out, const std::wstring& str) {
+	const std::string utf8 = pcu::toUTF8FromUTF16(str);
+	writeValue(out, static_cast<uint32_t>(utf8.size()));
+	out.write(utf8.data(), utf8.size());
+}
+
+bool readString(std::istream& in, std::wstring& str) {
+	size_t size = 0;
+	if (!readSize(in, size))
+		return false;
+	std::string utf8(size, '\0');
+	if (size > 0 && !in.read(&utf8[0], size))
+		return false;
+	str = pcu::toUTF16FromUTF8(utf8);
+	return true;
+}
+
+void writeAnnotation(std::ostream& out, const RuleInfo::Annotation& annotation) {
+	writeString(out, annotation.mName);
+	writeValue(out, static_cast<uint32_t>(annotation.mArguments.size()));
+	for (const RuleInfo::AnnotationArgument& argument : annotation.mArguments) {
+		writeString(out, argument.mKey);
+		writeValue(out, static_cast<int32_t>(argument.mType));
+		writeValue(out, static_cast<uint8_t>(argument.mBool));
+		writeValue(out, argument.mFloat);
+		writeString(out, argument.mString);
+	}
+}
+
+bool readAnnotation(std::istream& in, RuleInfo::Annotation& annotation) {
+	size_t nArguments = 0;
+	if (!readString(in, annotation.mName) || !readSize(in, nArguments))
+		return false;
+
+	annotation.mArguments.resize(nArguments);
+	for (RuleInfo::AnnotationArgument& argument : annotation.mArguments) {
+		int32_t type = 0;
+		uint8_t boolValue = 0;
+		if (!readString(in, argument.mKey) || !readValue(in, type) || !readValue(in, boolValue) ||
+		    !readValue(in, argument.mFloat) || !readString(in, argument.mString))
+			return false;
+		argument.mType = static_cast<prt::AnnotationArgumentType>(type);
+		argument.mBool = (boolValue != 0);
+	}
+	return true;
+}
+
+} // namespace
+
+RuleInfoPtr RuleInfo::create(const prt::ResolveMap* resolveMap, prt::Cache* cache) {
+	const std::wstring ruleFile = pcu::getRuleFileEntry(resolveMap);
+
+	const wchar_t* ruleFileURI = resolveMap->getString(ruleFile.c_str());
+	if (ruleFileURI == nullptr) {
+		LOG_ERR << "could not find rule file URI in resolve map";
+		return {};
+	}
+
+	prt::Status infoStatus = prt::STATUS_UNSPECIFIED_ERROR;
+	RuleFileInfoUPtr info(prt::createRuleFileInfo(ruleFileURI, cache, &infoStatus));
+	if (!info || infoStatus != prt::STATUS_OK) {
+		LOG_ERR << "could not get rule file info from rule file " << ruleFile;
+		return {};
+	}
+
+	std::shared_ptr<RuleInfo> ruleInfo(new RuleInfo());
+	ruleInfo->mRuleFile = ruleFile;
+	ruleInfo->mStartRule = pcu::detectStartRule(info);
+	ruleInfo->mHiddenAttrs = pcu::getHiddenAttributes(info);
+
+	const size_t styleLength = std::wcslen(CGA_STYLE_DEFAULT);
+	for (size_t i = 0; i < info->getNumAttributes(); i++) {
+		const prt::RuleFileInfo::Entry* attr = info->getAttribute(i);
+		const std::wstring fullName(attr->getName());
+		if (fullName.find(CGA_STYLE_DEFAULT) != 0)
+			continue;
+		if (attr->getNumParameters() > 0)
+			continue;
+
+		Attribute attribute;
+		attribute.mName = fullName.substr(styleLength);
+		attribute.mType = attr->getReturnType();
+		if (getAnnotations(attr, attribute.mAnnotations))
+			ruleInfo->mAttributes.push_back(std::move(attribute));
+	}
+
+	return ruleInfo;
+}
+
+const std::wstring& RuleInfo::getRuleFile() const {
+	return mRuleFile;
+}
+
+const std::wstring& RuleInfo::getStartRule() const {
+	return mStartRule;
+}
+
+const std::unordered_set<std::wstring>& RuleInfo::getHiddenAttributes() const {
+	return mHiddenAttrs;
+}
+
+const std::vector<RuleInfo::Attribute>& RuleInfo::getAttributes() const {
+	return mAttributes;
+}
+
+RuleInfoPtr RuleInfo::read(std::istream& in) {
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	if (!readValue(in, magic) || !readValue(in, version) || magic != SERIAL_MAGIC || version != SERIAL_VERSION)
+		return {};
+
+	std::shared_ptr<RuleInfo> ruleInfo(new RuleInfo());
+	size_t nHiddenAttrs = 0;
+	if (!readString(in, ruleInfo->mRuleFile) || !readString(in, ruleInfo->mStartRule) ||
+	    !readSize(in, nHiddenAttrs))
+		return {};
+
+	for (size_t i = 0; i < nHiddenAttrs; i++) {
+		std::wstring hiddenAttr;
+		if (!readString(in, hiddenAttr))
+			return {};
+		ruleInfo->mHiddenAttrs.insert(std::move(hiddenAttr));
+	}
+
+	size_t nAttributes = 0;
+	if (!readSize(in, nAttributes))
+		return {};
+
+	ruleInfo->mAttributes.resize(nAttributes);
+	for (Attribute& attribute : ruleInfo->mAttributes) {
+		int32_t type = 0;
+		size_t nAnnotations = 0;
+		if (!readString(in, attribute.mName) || !readValue(in, type) || !readSize(in, nAnnotations))
+			return {};
+		attribute.mType = static_cast<prt::AnnotationArgumentType>(type);
+
+		attribute.mAnnotations.resize(nAnnotations);
+		for (Annotation& annotation : attribute.mAnnotations) {
+			if (!readAnnotation(in, annotation))
+				return {};
+		}
+	}
+
+	return ruleInfo;
+}
+
+bool RuleInfo::write(std::ostream& out) const {
+	writeValue(out, SERIAL_MAGIC);
+	writeValue(out, SERIAL_VERSION);
+	writeString(out, mRuleFile);
+	writeString(out, mStartRule);
+
+	writeValue(out, static_cast<uint32_t>(mHiddenAttrs.size()));
+	for (const std::wstring& hiddenAttr : mHiddenAttrs)
+		writeString(out, hiddenAttr);
+
+	writeValue(out, static_cast<uint32_t>(mAttributes.size()));
+	for (const Attribute& attribute : mAttributes) {
+		writeString(out, attribute.mName);
+		writeValue(out, static_cast<int32_t>(attribute.mType));
+		writeValue(out, static_cast<uint32_t>(attribute.mAnnotations.size()));
+		for (const Annotation& annotation : attribute.mAnnotations)
+			writeAnnotation(out, annotation);
+	}
+
+	return static_cast<bool>(out);
+}
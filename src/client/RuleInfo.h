@@ -0,0 +1,78 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#pragma once
+
+#include "types.h"
+
+#include "prt/API.h"
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+class RuleInfo;
+using RuleInfoPtr = std::shared_ptr<const RuleInfo>;
+
+/**
+ * Rule metadata derived once from the rule file info of a rule package (start rule, hidden attributes, attribute
+ * types and annotations). Instances are immutable and shared between model generation and rule package inspection.
+ */
+class RuleInfo {
+public:
+	struct AnnotationArgument {
+		std::wstring mKey;
+		prt::AnnotationArgumentType mType = prt::AAT_UNKNOWN;
+		bool mBool = false;
+		double mFloat = 0.0;
+		std::wstring mString;
+	};
+
+	struct Annotation {
+		std::wstring mName;
+		std::vector<AnnotationArgument> mArguments;
+	};
+
+	struct Attribute {
+		std::wstring mName; // without the default style prefix
+		prt::AnnotationArgumentType mType = prt::AAT_UNKNOWN;
+		std::vector<Annotation> mAnnotations;
+	};
+
+	static RuleInfoPtr create(const prt::ResolveMap* resolveMap, prt::Cache* cache);
+
+	// compact binary form used for the on-disk rule info cache
+	static RuleInfoPtr read(std::istream& in);
+	bool write(std::ostream& out) const;
+
+	const std::wstring& getRuleFile() const;
+	const std::wstring& getStartRule() const;
+	const std::unordered_set<std::wstring>& getHiddenAttributes() const;
+	const std::vector<Attribute>& getAttributes() const;
+
+private:
+	RuleInfo() = default;
+
+	std::wstring mRuleFile;
+	std::wstring mStartRule;
+	std::unordered_set<std::wstring> mHiddenAttrs;
+	std::vector<Attribute> mAttributes;
+};
@@ -0,0 +1,210 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#include "RulePackageCache.h"
+#include "CachePool.h"
+#include "logging.h"
+#include "utils.h"
+
+#include <cstdlib>
+#include <system_error>
+
+namespace {
+
+constexpr const char* ENV_UNPACK_DIR = "PYPRT_RPK_UNPACK_DIR";
+
+// PRT caches the content of a rule package under the URIs of the resolve map (e.g. rpk:file:...!/bin/rule.cgb)
+std::vector<std::wstring> getCacheURIs(const std::wstring& rulePackageURI, const prt::ResolveMap& resolveMap) {
+	size_t nKeys = 0;
+	wchar_t const* const* keys = resolveMap.getKeys(&nKeys);
+
+	std::vector<std::wstring> uris;
+	uris.reserve(nKeys + 1);
+	uris.push_back(rulePackageURI);
+	for (size_t k = 0; k < nKeys; k++) {
+		const wchar_t* uri = resolveMap.getString(keys[k]);
+		if (uri != nullptr)
+			uris.emplace_back(uri);
+	}
+	return uris;
+}
+
+} // namespace
+
+RulePackageCache& RulePackageCache::get() {
+	static RulePackageCache theCache;
+	return theCache;
+}
+
+RulePackageCache::RulePackageCache() {
+	const char* unpackDirectory = std::getenv(ENV_UNPACK_DIR);
+	if (unpackDirectory != nullptr && unpackDirectory[0] != '\0')
+		mUnpackDirectory = std::make_shared<UnpackDirectory>(std::filesystem::path(unpackDirectory));
+}
+
+ResolveMapSPtr RulePackageCache::getResolveMap(const std::filesystem::path& rulePackagePath) {
+	const EntryPtr entry = getEntry(rulePackagePath);
+	return entry ? entry->mResolveMap : ResolveMapSPtr();
+}
+
+RuleInfoPtr RulePackageCache::getRuleInfo(const std::filesystem::path& rulePackagePath, ResolveMapSPtr* resolveMap) {
+	const EntryPtr entry = getEntry(rulePackagePath);
+	if (!entry)
+		return {};
+
+	if (resolveMap != nullptr)
+		*resolveMap = entry->mResolveMap;
+
+	std::call_once(entry->mRuleInfoFlag, [this, &entry, &rulePackagePath]() {
+		if (entry->mUnpackDirectory) {
+			entry->mRuleInfo = entry->mUnpackDirectory->readRuleInfo(entry->mContentHash);
+			if (entry->mRuleInfo) {
+				std::lock_guard<std::mutex> lock(mMutex);
+				mRuleInfoReads++;
+				return;
+			}
+		}
+
+		entry->mRuleInfo = RuleInfo::create(entry->mResolveMap.get(), CachePool::get().getCache().get());
+		if (!entry->mRuleInfo) {
+			LOG_ERR << "could not get rule info of rule package " << rulePackagePath;
+			return;
+		}
+		if (entry->mUnpackDirectory && entry->mUnpackDirectory->writeRuleInfo(entry->mContentHash, *entry->mRuleInfo)) {
+			std::lock_guard<std::mutex> lock(mMutex);
+			mRuleInfoWrites++;
+		}
+	});
+	return entry->mRuleInfo;
+}
+
+RulePackageCache::EntryPtr RulePackageCache::getEntry(const std::filesystem::path& rulePackagePath) {
+	std::error_code ec;
+	const std::filesystem::path canonicalPath = std::filesystem::canonical(rulePackagePath, ec);
+	if (ec) {
+		LOG_ERR << "could not resolve rule package path " << rulePackagePath << ": " << ec.message();
+		return {};
+	}
+
+	FileStamp stamp;
+	stamp.mSize = std::filesystem::file_size(canonicalPath, ec);
+	if (!ec)
+		stamp.mModificationTime = std::filesystem::last_write_time(canonicalPath, ec);
+	if (ec) {
+		LOG_ERR << "could not read file status of rule package " << canonicalPath << ": " << ec.message();
+		return {};
+	}
+
+	const std::wstring key = canonicalPath.wstring();
+	EntryPtr entry;
+	EntryPtr outdatedEntry;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		const auto it = mEntries.find(key);
+		if (it != mEntries.end() && it->second->mStamp == stamp) {
+			mHits++;
+			entry = it->second;
+		}
+		else {
+			mMisses++;
+			if (it != mEntries.end())
+				outdatedEntry = it->second;
+		}
+	}
+	if (entry) {
+		// keeps the rule package at the front of the shared cache's eviction order
+		CachePool::get().track(entry->mCacheKey, entry->mCacheURIs, entry->mStamp.mSize);
+		return entry;
+	}
+
+	// the rewritten rule package has the same URIs, the shared cache must not serve its old content
+	if (outdatedEntry)
+		CachePool::get().flushEntry(outdatedEntry->mCacheKey);
+
+	std::shared_ptr<const UnpackDirectory> unpackDirectory;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		unpackDirectory = mUnpackDirectory;
+	}
+
+	// the resolve map is created outside of the lock, concurrent misses on the same rule package are harmless
+	entry = std::make_shared<Entry>();
+	ResolveMapPtr resolveMap;
+	if (unpackDirectory) {
+		resolveMap = unpackDirectory->getResolveMap(canonicalPath, &entry->mContentHash);
+		if (resolveMap)
+			entry->mUnpackDirectory = unpackDirectory;
+	}
+	if (!resolveMap && (!pcu::getResolveMap(canonicalPath, &resolveMap) || !resolveMap))
+		return {};
+
+	entry->mStamp = stamp;
+	entry->mCacheKey = pcu::toUTF16FromUTF8(pcu::toFileURI(canonicalPath.string()));
+	entry->mCacheURIs = getCacheURIs(entry->mCacheKey, *resolveMap);
+	CachePool::get().track(entry->mCacheKey, entry->mCacheURIs, stamp.mSize);
+	entry->mResolveMap.reset(resolveMap.release(), PRTDestroyer());
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mEntries[key] = entry;
+	}
+	return entry;
+}
+
+void RulePackageCache::clear() {
+	std::lock_guard<std::mutex> lock(mMutex);
+	mEntries.clear();
+}
+
+void RulePackageCache::setUnpackDirectory(const std::filesystem::path& unpackDirectory) {
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (unpackDirectory.empty())
+		mUnpackDirectory.reset();
+	else
+		mUnpackDirectory = std::make_shared<UnpackDirectory>(unpackDirectory);
+}
+
+std::filesystem::path RulePackageCache::getUnpackDirectory() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mUnpackDirectory ? mUnpackDirectory->getRoot() : std::filesystem::path();
+}
+
+size_t RulePackageCache::getHitCount() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mHits;
+}
+
+size_t RulePackageCache::getMissCount() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mMisses;
+}
+
+size_t RulePackageCache::getEntryCount() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mEntries.size();
+}
+
+size_t RulePackageCache::getRuleInfoReadCount() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mRuleInfoReads;
+}
+
+size_t RulePackageCache::getRuleInfoWriteCount() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mRuleInfoWrites;
+}
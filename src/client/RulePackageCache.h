@@ -0,0 +1,99 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#pragma once
+
+#include "RuleInfo.h"
+#include "UnpackDirectory.h"
+#include "types.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Process-wide cache of rule package resolve maps and their rule info. Entries are keyed by the canonical rule package
+ * path and are invalidated as soon as the size or the modification time of the rule package file changes.
+ *
+ * If an unpack directory is set (or the PYPRT_RPK_UNPACK_DIR environment variable is defined), rule packages are
+ * extracted into it once and reused by all later processes, together with their rule info.
+ */
+class RulePackageCache {
+public:
+	static RulePackageCache& get();
+
+	RulePackageCache();
+	RulePackageCache(const RulePackageCache&) = delete;
+	RulePackageCache& operator=(const RulePackageCache&) = delete;
+	~RulePackageCache() = default;
+
+	ResolveMapSPtr getResolveMap(const std::filesystem::path& rulePackagePath);
+	RuleInfoPtr getRuleInfo(const std::filesystem::path& rulePackagePath, ResolveMapSPtr* resolveMap = nullptr);
+	void clear();
+
+	void setUnpackDirectory(const std::filesystem::path& unpackDirectory);
+	std::filesystem::path getUnpackDirectory() const;
+
+	size_t getHitCount() const;
+	size_t getMissCount() const;
+	size_t getEntryCount() const;
+	size_t getRuleInfoReadCount() const;
+	size_t getRuleInfoWriteCount() const;
+
+private:
+	struct FileStamp {
+		uintmax_t mSize = 0;
+		std::filesystem::file_time_type mModificationTime;
+
+		bool operator==(const FileStamp& other) const {
+			return mSize == other.mSize && mModificationTime == other.mModificationTime;
+		}
+	};
+
+	struct Entry {
+		FileStamp mStamp;
+		ResolveMapSPtr mResolveMap;
+
+		// the rule package file URI and the URIs PRT caches its content under, see CachePool
+		std::wstring mCacheKey;
+		std::vector<std::wstring> mCacheURIs;
+
+		// set if the rule package was resolved through an unpack directory
+		std::shared_ptr<const UnpackDirectory> mUnpackDirectory;
+		std::string mContentHash;
+
+		std::once_flag mRuleInfoFlag;
+		RuleInfoPtr mRuleInfo; // lazily created (or read from the unpack directory) on first request
+	};
+	using EntryPtr = std::shared_ptr<Entry>;
+
+	EntryPtr getEntry(const std::filesystem::path& rulePackagePath);
+
+	mutable std::mutex mMutex;
+	std::unordered_map<std::wstring, EntryPtr> mEntries;
+	std::shared_ptr<const UnpackDirectory> mUnpackDirectory;
+	size_t mHits = 0;
+	size_t mMisses = 0;
+	size_t mRuleInfoReads = 0;  // read from the unpack directory
+	size_t mRuleInfoWrites = 0; // written to the unpack directory
+};
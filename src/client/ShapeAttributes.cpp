@@ -0,0 +1,155 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#include "ShapeAttributes.h"
+#include "AttributeMapCache.h"
+#include "utils.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace py = pybind11;
+
+ShapeAttributes::ShapeAttributes(std::vector<py::dict> shapeAttributes) : mDicts(std::move(shapeAttributes)) {}
+
+ShapeAttributes::ShapeAttributes(const py::dict& columns, size_t shapeCount) {
+	auto nativeColumns = std::make_shared<std::vector<Column>>();
+	nativeColumns->reserve(columns.size());
+	for (const auto& item : columns)
+		nativeColumns->push_back(toColumn(item.first.cast<std::wstring>(), item.second, shapeCount));
+	mColumns = std::move(nativeColumns);
+}
+
+bool ShapeAttributes::isColumnar() const {
+	return static_cast<bool>(mColumns);
+}
+
+// a single dict applies to all initial shapes
+bool ShapeAttributes::isBroadcast() const {
+	return !mColumns && (mDicts.size() == 1);
+}
+
+size_t ShapeAttributes::getDictCount() const {
+	return mDicts.size();
+}
+
+/**
+ * Dict shape attributes are converted with the Python API and need the GIL, they are looked up in the attribute map
+ * cache by content. Columnar ones are built with the given builder and do not touch Python objects.
+ */
+AttributeMapSPtr ShapeAttributes::getAttributeMap(size_t shapeIndex, prt::AttributeMapBuilder& builder) const {
+	if (!mColumns) {
+		const py::dict& shapeAttributes = (mDicts.size() > shapeIndex) ? mDicts[shapeIndex] : mDicts[0];
+		return AttributeMapCache::get().getAttributeMap(shapeAttributes);
+	}
+
+	for (const Column& column : *mColumns) {
+		const size_t row = column.mBroadcast ? 0 : shapeIndex;
+		const wchar_t* key = column.mKey.c_str();
+		if (const auto* values = std::get_if<std::vector<bool>>(&column.mValues))
+			builder.setBool(key, (*values)[row]);
+		else if (const auto* values = std::get_if<std::vector<double>>(&column.mValues))
+			builder.setFloat(key, (*values)[row]);
+		else if (const auto* values = std::get_if<std::vector<int32_t>>(&column.mValues))
+			builder.setInt(key, (*values)[row]);
+		else if (const auto* values = std::get_if<std::vector<std::wstring>>(&column.mValues))
+			builder.setString(key, (*values)[row].c_str());
+	}
+	return AttributeMapSPtr{builder.createAttributeMapAndReset(), PRTDestroyer()};
+}
+
+/**
+ * Scalars are broadcast to all initial shapes. Numeric buffers (e.g. NumPy arrays) are converted natively, the type
+ * of other sequences is given by their first element like for dict shape attributes.
+ */
+ShapeAttributes::Column ShapeAttributes::toColumn(const std::wstring& key, const py::handle& values,
+                                                  size_t shapeCount) {
+	Column column;
+	column.mKey = key;
+
+	if (py::isinstance<py::bool_>(values)) { // check for boolean first, bool is an int in Python
+		column.mValues = std::vector<bool>{values.cast<bool>()};
+		column.mBroadcast = true;
+		return column;
+	}
+	else if (py::isinstance<py::float_>(values)) {
+		column.mValues = std::vector<double>{values.cast<double>()};
+		column.mBroadcast = true;
+		return column;
+	}
+	else if (py::isinstance<py::int_>(values)) {
+		column.mValues = std::vector<int32_t>{values.cast<int32_t>()};
+		column.mBroadcast = true;
+		return column;
+	}
+	else if (py::isinstance<py::str>(values)) {
+		column.mValues = std::vector<std::wstring>{values.cast<std::wstring>()};
+		column.mBroadcast = true;
+		return column;
+	}
+
+	bool converted = false;
+	if (PyObject_CheckBuffer(values.ptr())) {
+		const py::buffer_info info = py::reinterpret_borrow<py::buffer>(values).request();
+		const std::string format = info.format;
+		const char type = format.empty() ? '\0' : format.back();
+		const py::object object = py::reinterpret_borrow<py::object>(values);
+		if (type == '?') {
+			const std::vector<uint8_t> bytes = pcu::toVector<uint8_t>(object);
+			column.mValues = std::vector<bool>(bytes.begin(), bytes.end());
+			converted = true;
+		}
+		else if (type == 'f' || type == 'd' || type == 'e') {
+			column.mValues = pcu::toVector<double>(object);
+			converted = true;
+		}
+		else if (std::string("bBhHiIlLqQ").find(type) != std::string::npos) {
+			column.mValues = pcu::toVector<int32_t>(object);
+			converted = true;
+		}
+		column.mBroadcast = converted && (info.ndim == 0);
+	}
+
+	if (!converted) {
+		if (!py::isinstance<py::sequence>(values))
+			throw std::invalid_argument("unsupported values for shape attribute column '" + pcu::toUTF8FromUTF16(key) +
+			                            "'.");
+
+		const py::sequence sequence = py::reinterpret_borrow<py::sequence>(values);
+		const py::object first = (sequence.size() > 0) ? py::object(sequence[0]) : py::float_(0.0);
+		if (py::isinstance<py::bool_>(first))
+			column.mValues = values.cast<std::vector<bool>>();
+		else if (py::isinstance<py::float_>(first))
+			column.mValues = values.cast<std::vector<double>>();
+		else if (py::isinstance<py::int_>(first))
+			column.mValues = values.cast<std::vector<int32_t>>();
+		else if (py::isinstance<py::str>(first))
+			column.mValues = values.cast<std::vector<std::wstring>>();
+		else
+			throw std::invalid_argument("unsupported value type in shape attribute column '" +
+			                            pcu::toUTF8FromUTF16(key) + "'.");
+	}
+
+	const size_t rowCount = std::visit([](const auto& v) { return v.size(); }, column.mValues);
+	if (!column.mBroadcast && rowCount != shapeCount)
+		throw std::invalid_argument("shape attribute column '" + pcu::toUTF8FromUTF16(key) + "' has " +
+		                            std::to_string(rowCount) + " values but there are " + std::to_string(shapeCount) +
+		                            " initial shapes.");
+	return column;
+}
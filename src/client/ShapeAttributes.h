@@ -0,0 +1,61 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#pragma once
+
+#include "types.h"
+
+#include "prt/API.h"
+
+#include "pybind11/pybind11.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+/**
+ * The shape attributes of a generate call: either one Python dict per initial shape (or one dict for all of them), or
+ * columns with one value per initial shape which are converted once into native storage. Attribute maps of columnar
+ * shape attributes are created without touching Python objects.
+ */
+class ShapeAttributes {
+public:
+	explicit ShapeAttributes(std::vector<pybind11::dict> shapeAttributes);
+	ShapeAttributes(const pybind11::dict& columns, size_t shapeCount);
+
+	bool isColumnar() const;
+	bool isBroadcast() const;
+	size_t getDictCount() const;
+
+	AttributeMapSPtr getAttributeMap(size_t shapeIndex, prt::AttributeMapBuilder& builder) const;
+
+private:
+	struct Column {
+		std::wstring mKey;
+		std::variant<std::vector<bool>, std::vector<double>, std::vector<int32_t>, std::vector<std::wstring>> mValues;
+		bool mBroadcast = false; // a single value for all initial shapes
+	};
+
+	std::vector<pybind11::dict> mDicts;
+	std::shared_ptr<const std::vector<Column>> mColumns; // null for dict shape attributes
+
+	static Column toColumn(const std::wstring& key, const pybind11::handle& values, size_t shapeCount);
+};
@@ -0,0 +1,100 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#include "ThreadPool.h"
+#include "logging.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <iterator>
+
+ThreadPool& ThreadPool::get() {
+	static ThreadPool thePool(pcu::getThreadCount(0));
+	return thePool;
+}
+
+ThreadPool::ThreadPool(size_t threadCount) : mThreadCount(std::max<size_t>(threadCount, 1)) {}
+
+ThreadPool::~ThreadPool() {
+	stop();
+}
+
+/**
+ * Queues a task, returns false if the pool has already been stopped.
+ */
+bool ThreadPool::submit(Task task) {
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (mStopped)
+			return false;
+
+		if (mThreads.empty()) {
+			mThreads.reserve(mThreadCount);
+			for (size_t t = 0; t < mThreadCount; t++)
+				mThreads.emplace_back(&ThreadPool::run, this);
+		}
+		mTasks.push_back(std::move(task));
+	}
+	mCondition.notify_one();
+	return true;
+}
+
+/**
+ * Waits for the running tasks and stops the workers. The tasks which have not been started yet are returned to the
+ * caller instead of being destroyed here, they might hold resources which need special care on destruction.
+ */
+std::vector<ThreadPool::Task> ThreadPool::stop() {
+	std::vector<Task> pending;
+	std::vector<std::thread> threads;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mStopped = true;
+		pending.assign(std::make_move_iterator(mTasks.begin()), std::make_move_iterator(mTasks.end()));
+		mTasks.clear();
+		threads.swap(mThreads);
+	}
+	mCondition.notify_all();
+
+	for (std::thread& thread : threads)
+		thread.join();
+	return pending;
+}
+
+void ThreadPool::run() {
+	while (true) {
+		Task task;
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mCondition.wait(lock, [this]() { return mStopped || !mTasks.empty(); });
+			if (mStopped)
+				return;
+			task = std::move(mTasks.front());
+			mTasks.pop_front();
+		}
+		try {
+			task();
+		}
+		catch (const std::exception& e) {
+			LOG_ERR << "caught exception in worker thread: " << e.what();
+		}
+		catch (...) {
+			LOG_ERR << "caught unknown exception in worker thread.";
+		}
+	}
+}
@@ -0,0 +1,56 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed-size pool of native worker threads running queued tasks in submission order. The workers are started on the
+ * first submitted task.
+ */
+class ThreadPool {
+public:
+	using Task = std::function<void()>;
+
+	static ThreadPool& get();
+
+	explicit ThreadPool(size_t threadCount);
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	~ThreadPool();
+
+	bool submit(Task task);
+	std::vector<Task> stop();
+
+private:
+	void run();
+
+	const size_t mThreadCount;
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+	std::deque<Task> mTasks;
+	std::vector<std::thread> mThreads;
+	bool mStopped = false;
+};
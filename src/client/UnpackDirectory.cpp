@@ -0,0 +1,374 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#include "UnpackDirectory.h"
+#include "logging.h"
+#include "utils.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <system_error>
+#include <thread>
+
+namespace {
+
+constexpr const char* MANIFEST_FILE = "resolvemap.txt";
+constexpr const char* LOCK_SUFFIX = ".lock";
+constexpr const char* TMP_SUFFIX = ".tmp-";
+constexpr const char* RULE_INFO_SUFFIX = ".ruleinfo";
+
+// placeholders for the parts of the resolve map values which depend on the extracting process
+const std::wstring PLACEHOLDER_UNPACK_DIR = L"$UNPACK_DIR/";
+const std::wstring PLACEHOLDER_RPK_URI = L"$RPK_URI";
+
+const std::chrono::milliseconds LOCK_POLL_INTERVAL(50);
+const std::chrono::minutes LOCK_TIMEOUT(10);
+
+// the lock holder refreshes its lock file, a lock which was not refreshed for a while is left over by a crashed process
+const std::chrono::seconds LOCK_REFRESH_INTERVAL(15);
+const std::chrono::minutes LOCK_STALE_AGE(1);
+
+std::wstring toRPKURI(const std::filesystem::path& rulePackagePath) {
+	return pcu::toUTF16FromUTF8(pcu::toFileURI(rulePackagePath.string()));
+}
+
+/**
+ * Converts a file URI created by PRT back into a file system path, returns an empty path for any other URI.
+ */
+std::filesystem::path toFilePath(const std::wstring& uri) {
+	const std::wstring fileScheme = L"file:";
+	if (uri.compare(0, fileScheme.size(), fileScheme) != 0)
+		return {};
+
+	std::string path = pcu::toUTF8FromUTF16(uri.substr(fileScheme.size()));
+	if (path.compare(0, 2, "//") == 0)
+		path.erase(0, 2);
+#ifdef _WIN32
+	if (path.size() > 2 && path[0] == '/' && path[2] == ':')
+		path.erase(0, 1);
+#endif
+
+	auto hexValue = [](char c) -> int {
+		if (c >= '0' && c <= '9')
+			return c - '0';
+		if (c >= 'a' && c <= 'f')
+			return c - 'a' + 10;
+		if (c >= 'A' && c <= 'F')
+			return c - 'A' + 10;
+		return -1;
+	};
+
+	std::string decoded;
+	decoded.reserve(path.size());
+	for (size_t i = 0; i < path.size(); i++) {
+		const int hi = (path[i] == '%' && i + 2 < path.size()) ? hexValue(path[i + 1]) : -1;
+		const int lo = (hi >= 0) ? hexValue(path[i + 2]) : -1;
+		if (lo >= 0) {
+			decoded.push_back(static_cast<char>(hi * 16 + lo));
+			i += 2;
+		}
+		else
+			decoded.push_back(path[i]);
+	}
+	return std::filesystem::u8path(decoded);
+}
+
+std::string getUniqueSuffix() {
+	std::random_device rd;
+	return std::to_string(rd()) + std::to_string(rd());
+}
+
+/**
+ * Returns the owner token written into the lock file, or an empty string if the lock is held by someone else. The
+ * token tells a waiter whether a stale lock was replaced by a new one in the meantime.
+ */
+std::string tryCreateLockFile(const std::filesystem::path& lockFile) {
+	// "x" makes the creation exclusive, i.e. it fails if the file already exists
+	std::FILE* f = std::fopen(lockFile.string().c_str(), "wx");
+	if (f == nullptr)
+		return {};
+	const std::string owner = getUniqueSuffix();
+	std::fputs(owner.c_str(), f);
+	std::fclose(f);
+	return owner;
+}
+
+struct LockState {
+	std::string mOwner;
+	std::filesystem::file_time_type mLastWrite;
+
+	bool operator==(const LockState& other) const {
+		return mOwner == other.mOwner && mLastWrite == other.mLastWrite;
+	}
+};
+
+std::optional<LockState> readLockState(const std::filesystem::path& lockFile) {
+	std::error_code ec;
+	LockState state;
+	state.mLastWrite = std::filesystem::last_write_time(lockFile, ec);
+	if (ec)
+		return {};
+	std::ifstream in(lockFile, std::ios::binary);
+	std::getline(in, state.mOwner);
+	return state;
+}
+
+bool isStaleLock(const LockState& state) {
+	return std::filesystem::file_time_type::clock::now() - state.mLastWrite > LOCK_STALE_AGE;
+}
+
+/**
+ * Refreshes the modification time of a lock file until destroyed, waiting processes then do not mistake a long
+ * extraction for a crashed one.
+ */
+class LockRefresher {
+public:
+	explicit LockRefresher(const std::filesystem::path& lockFile) : mLockFile(lockFile), mThread([this]() { run(); }) {}
+	LockRefresher(const LockRefresher&) = delete;
+	LockRefresher& operator=(const LockRefresher&) = delete;
+
+	~LockRefresher() {
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mStopped = true;
+		}
+		mCondition.notify_all();
+		mThread.join();
+	}
+
+private:
+	void run() {
+		std::unique_lock<std::mutex> lock(mMutex);
+		while (!mCondition.wait_for(lock, LOCK_REFRESH_INTERVAL, [this]() { return mStopped; })) {
+			std::error_code ec;
+			std::filesystem::last_write_time(mLockFile, std::filesystem::file_time_type::clock::now(), ec);
+		}
+	}
+
+	const std::filesystem::path mLockFile;
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+	bool mStopped = false;
+	std::thread mThread; // started last
+};
+
+ResolveMapPtr readManifest(const std::filesystem::path& unpackDir, const std::filesystem::path& rulePackagePath) {
+	std::ifstream manifest(unpackDir / MANIFEST_FILE, std::ios::binary);
+	if (!manifest)
+		return {};
+
+	const std::string unpackDirURI = pcu::toFileURI(unpackDir.generic_string()) + "/";
+	const std::wstring rpkURI = toRPKURI(rulePackagePath);
+
+	ResolveMapBuilderPtr builder(prt::ResolveMapBuilder::create());
+	std::string line;
+	while (std::getline(manifest, line)) {
+		const size_t sep = line.find('\t');
+		if (sep == std::string::npos)
+			continue;
+
+		const std::wstring key = pcu::toUTF16FromUTF8(line.substr(0, sep));
+		std::wstring value = pcu::toUTF16FromUTF8(line.substr(sep + 1));
+		if (value.compare(0, PLACEHOLDER_UNPACK_DIR.size(), PLACEHOLDER_UNPACK_DIR) == 0) {
+			const std::string relativePath = pcu::toUTF8FromUTF16(value.substr(PLACEHOLDER_UNPACK_DIR.size()));
+			value = pcu::toUTF16FromUTF8(unpackDirURI + pcu::percentEncode(relativePath));
+		}
+		for (size_t pos = value.find(PLACEHOLDER_RPK_URI); pos != std::wstring::npos;
+		     pos = value.find(PLACEHOLDER_RPK_URI, pos + rpkURI.size()))
+			value.replace(pos, PLACEHOLDER_RPK_URI.size(), rpkURI);
+
+		builder->addEntry(key.c_str(), value.c_str());
+	}
+
+	prt::Status status = prt::STATUS_UNSPECIFIED_ERROR;
+	ResolveMapPtr resolveMap(builder->createResolveMap(&status));
+	if (status != prt::STATUS_OK) {
+		LOG_ERR << "could not rebuild resolve map from " << (unpackDir / MANIFEST_FILE);
+		return {};
+	}
+	return resolveMap;
+}
+
+} // namespace
+
+UnpackDirectory::UnpackDirectory(const std::filesystem::path& root) : mRoot(root) {}
+
+const std::filesystem::path& UnpackDirectory::getRoot() const {
+	return mRoot;
+}
+
+/**
+ * Returns the resolve map of the rule package unpacked in this directory. The first process unpacking a rule package
+ * holds a lock file while extracting into a temporary directory, which is then atomically renamed. Concurrent
+ * processes wait for the lock to disappear. Returns nullptr if the directory cannot be used. The content hash of the
+ * rule package is returned for use with readRuleInfo/writeRuleInfo.
+ */
+ResolveMapPtr UnpackDirectory::getResolveMap(const std::filesystem::path& rulePackagePath,
+                                             std::string* contentHash) const {
+	const std::string hash = pcu::getContentHash(rulePackagePath);
+	if (hash.empty())
+		return {};
+	if (contentHash != nullptr)
+		*contentHash = hash;
+
+	const std::filesystem::path unpackDir = mRoot / hash;
+	const std::filesystem::path lockFile = mRoot / (hash + LOCK_SUFFIX);
+
+	std::error_code ec;
+	std::filesystem::create_directories(mRoot, ec);
+	if (ec) {
+		LOG_ERR << "could not create rule package unpack directory " << mRoot << ": " << ec.message();
+		return {};
+	}
+
+	const auto deadline = std::chrono::steady_clock::now() + LOCK_TIMEOUT;
+	while (std::chrono::steady_clock::now() < deadline) {
+		if (std::filesystem::exists(unpackDir / MANIFEST_FILE, ec))
+			return readManifest(unpackDir, rulePackagePath);
+
+		const std::string owner = tryCreateLockFile(lockFile);
+		if (!owner.empty()) {
+			// another process might have finished between our check and taking the lock
+			bool ready = std::filesystem::exists(unpackDir / MANIFEST_FILE, ec);
+			if (!ready) {
+				const LockRefresher refresher(lockFile);
+				const std::filesystem::path tmpDir = mRoot / (hash + TMP_SUFFIX + getUniqueSuffix());
+				ready = extract(rulePackagePath, tmpDir);
+				if (ready) {
+					// a directory without manifest is left over by a crashed extraction, nobody else uses it
+					if (std::filesystem::exists(unpackDir, ec)) {
+						LOG_WRN << "removing incomplete unpacked rule package " << unpackDir;
+						std::filesystem::remove_all(unpackDir, ec);
+					}
+					std::filesystem::rename(tmpDir, unpackDir, ec);
+					if (ec) {
+						LOG_WRN << "could not move unpacked rule package to " << unpackDir << ": " << ec.message();
+						ready = false;
+					}
+				}
+				std::filesystem::remove_all(tmpDir, ec);
+			}
+
+			// our lock might have been taken for a stale one and replaced by another process
+			const std::optional<LockState> lockState = readLockState(lockFile);
+			if (lockState && lockState->mOwner == owner)
+				std::filesystem::remove(lockFile, ec);
+			return ready ? readManifest(unpackDir, rulePackagePath) : ResolveMapPtr();
+		}
+
+		const std::optional<LockState> lockState = readLockState(lockFile);
+		if (lockState && isStaleLock(*lockState)) {
+			// another waiter might have removed the stale lock and taken a new one meanwhile
+			if (readLockState(lockFile) == lockState) {
+				LOG_WRN << "removing stale rule package lock file " << lockFile;
+				std::filesystem::remove(lockFile, ec);
+			}
+			continue;
+		}
+
+		std::this_thread::sleep_for(LOCK_POLL_INTERVAL);
+	}
+
+	LOG_WRN << "timeout while waiting for rule package lock " << lockFile;
+	return {};
+}
+
+RuleInfoPtr UnpackDirectory::readRuleInfo(const std::string& contentHash) const {
+	std::ifstream in(mRoot / (contentHash + RULE_INFO_SUFFIX), std::ios::binary);
+	if (!in)
+		return {};
+
+	RuleInfoPtr ruleInfo = RuleInfo::read(in);
+	if (!ruleInfo)
+		LOG_WRN << "ignoring invalid rule info cache file " << (mRoot / (contentHash + RULE_INFO_SUFFIX));
+	return ruleInfo;
+}
+
+/**
+ * Writes the rule info into a temporary file which is then renamed, concurrent readers either see the complete
+ * file or none. Failures are not fatal, the rule info is simply created again by the next process.
+ */
+bool UnpackDirectory::writeRuleInfo(const std::string& contentHash, const RuleInfo& ruleInfo) const {
+	const std::filesystem::path ruleInfoFile = mRoot / (contentHash + RULE_INFO_SUFFIX);
+	const std::filesystem::path tmpFile = mRoot / (contentHash + RULE_INFO_SUFFIX + TMP_SUFFIX + getUniqueSuffix());
+
+	std::ofstream out(tmpFile, std::ios::binary);
+	const bool written = ruleInfo.write(out);
+	out.close();
+
+	std::error_code ec;
+	if (written && out)
+		std::filesystem::rename(tmpFile, ruleInfoFile, ec);
+	if (!written || !out || ec) {
+		LOG_WRN << "could not write rule info cache file " << ruleInfoFile;
+		std::filesystem::remove(tmpFile, ec);
+		return false;
+	}
+	return true;
+}
+
+bool UnpackDirectory::extract(const std::filesystem::path& rulePackagePath,
+                              const std::filesystem::path& targetDir) const {
+	std::error_code ec;
+	std::filesystem::create_directories(targetDir, ec);
+	if (ec) {
+		LOG_ERR << "could not create directory " << targetDir << ": " << ec.message();
+		return false;
+	}
+
+	LOG_INF << "unpacking rule package " << rulePackagePath << " into " << targetDir;
+
+	const std::wstring rpkURI = toRPKURI(rulePackagePath);
+	prt::Status status = prt::STATUS_UNSPECIFIED_ERROR;
+	const ResolveMapPtr resolveMap(prt::createResolveMap(rpkURI.c_str(), targetDir.wstring().c_str(), &status));
+	if (!resolveMap || status != prt::STATUS_OK) {
+		LOG_ERR << "unpacking rule package " << rulePackagePath << " failed";
+		return false;
+	}
+
+	// the manifest is written last, its existence marks a complete extraction
+	std::ofstream manifest(targetDir / MANIFEST_FILE, std::ios::binary);
+	size_t nKeys = 0;
+	wchar_t const* const* keys = resolveMap->getKeys(&nKeys);
+	for (size_t k = 0; k < nKeys; k++) {
+		std::wstring value = resolveMap->getString(keys[k]);
+
+		const std::filesystem::path valuePath = toFilePath(value);
+		const std::filesystem::path relativePath =
+		        valuePath.empty() ? std::filesystem::path() : valuePath.lexically_relative(targetDir);
+		if (!relativePath.empty() && *relativePath.begin() != "..") {
+			value = PLACEHOLDER_UNPACK_DIR + pcu::toUTF16FromUTF8(relativePath.generic_u8string());
+		}
+		else {
+			for (size_t pos = value.find(rpkURI); pos != std::wstring::npos;
+			     pos = value.find(rpkURI, pos + PLACEHOLDER_RPK_URI.size()))
+				value.replace(pos, rpkURI.size(), PLACEHOLDER_RPK_URI);
+		}
+
+		manifest << pcu::toUTF8FromUTF16(keys[k]) << '\t' << pcu::toUTF8FromUTF16(value) << '\n';
+	}
+	manifest.close();
+
+	return static_cast<bool>(manifest);
+}
@@ -0,0 +1,47 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#pragma once
+
+#include "RuleInfo.h"
+#include "types.h"
+
+#include <filesystem>
+#include <string>
+
+/**
+ * Directory of unpacked rule packages shared between processes. Each rule package is extracted once into a
+ * sub-directory named after its content hash, together with a manifest of its resolve map entries. Later processes
+ * rebuild the resolve map from the manifest instead of extracting the rule package again. The rule info of a rule
+ * package is stored in a binary sidecar file next to it, so later processes do not need to compile it again.
+ */
+class UnpackDirectory {
+public:
+	explicit UnpackDirectory(const std::filesystem::path& root);
+
+	ResolveMapPtr getResolveMap(const std::filesystem::path& rulePackagePath, std::string* contentHash = nullptr) const;
+	RuleInfoPtr readRuleInfo(const std::string& contentHash) const;
+	bool writeRuleInfo(const std::string& contentHash, const RuleInfo& ruleInfo) const;
+	const std::filesystem::path& getRoot() const;
+
+private:
+	bool extract(const std::filesystem::path& rulePackagePath, const std::filesystem::path& targetDir) const;
+
+	std::filesystem::path mRoot;
+};
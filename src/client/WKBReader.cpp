@@ -0,0 +1,210 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#include "WKBReader.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+constexpr uint32_t WKB_POLYGON = 3;
+constexpr uint32_t WKB_MULTI_POLYGON = 6;
+
+constexpr uint32_t EWKB_Z_FLAG = 0x80000000;
+constexpr uint32_t EWKB_M_FLAG = 0x40000000;
+constexpr uint32_t EWKB_SRID_FLAG = 0x20000000;
+
+constexpr size_t GEOMETRIES_PER_WORK_UNIT = 1024;
+
+// geometry of one WKB shape, always with x/y/z coordinates
+struct Polygons {
+	Coordinates mCoordinates;
+	InitialShapeBatch::Offsets mRingSizes;
+	InitialShapeBatch::Offsets mPolygonRingCounts;
+};
+
+class Parser {
+public:
+	Parser(const uint8_t* data, size_t size) : mData(data), mSize(size) {}
+
+	void readGeometry(Polygons& polygons, bool polygonOnly) {
+		const bool bigEndian = (readByte() == 0);
+		uint32_t type = readUInt32(bigEndian);
+
+		bool hasZ = (type & EWKB_Z_FLAG) != 0;
+		bool hasM = (type & EWKB_M_FLAG) != 0;
+		if (type & EWKB_SRID_FLAG)
+			readUInt32(bigEndian);
+		type &= 0x0FFFFFFF;
+
+		// ISO WKB encodes the dimensions in the thousands: 1000 Z, 2000 M, 3000 ZM
+		const uint32_t isoDimensions = type / 1000;
+		type %= 1000;
+		hasZ = hasZ || isoDimensions == 1 || isoDimensions == 3;
+		hasM = hasM || isoDimensions == 2 || isoDimensions == 3;
+
+		if (type == WKB_POLYGON) {
+			readPolygon(polygons, bigEndian, hasZ, hasM);
+		}
+		else if (type == WKB_MULTI_POLYGON && !polygonOnly) {
+			const uint32_t polygonCount = readUInt32(bigEndian);
+			for (uint32_t p = 0; p < polygonCount; p++)
+				readGeometry(polygons, true);
+		}
+		else {
+			throw std::invalid_argument("unsupported WKB geometry type " + std::to_string(type) +
+			                            ", only Polygon and MultiPolygon are supported.");
+		}
+	}
+
+	bool atEnd() const {
+		return mPos == mSize;
+	}
+
+private:
+	void readPolygon(Polygons& polygons, bool bigEndian, bool hasZ, bool hasM) {
+		const size_t dimensions = 2 + (hasZ ? 1 : 0) + (hasM ? 1 : 0);
+		const uint32_t ringCount = readUInt32(bigEndian);
+		for (uint32_t r = 0; r < ringCount; r++) {
+			const uint32_t pointCount = readUInt32(bigEndian);
+			require(static_cast<uint64_t>(pointCount) * dimensions * sizeof(double));
+			polygons.mCoordinates.reserve(polygons.mCoordinates.size() + 3 * pointCount);
+			for (uint32_t v = 0; v < pointCount; v++) {
+				const double x = readDouble(bigEndian);
+				const double y = readDouble(bigEndian);
+				const double z = hasZ ? readDouble(bigEndian) : 0.0;
+				if (hasM)
+					readDouble(bigEndian);
+				polygons.mCoordinates.push_back(x);
+				polygons.mCoordinates.push_back(y);
+				polygons.mCoordinates.push_back(z);
+			}
+			polygons.mRingSizes.push_back(pointCount);
+		}
+		polygons.mPolygonRingCounts.push_back(ringCount);
+	}
+
+	void require(uint64_t byteCount) const {
+		if (byteCount > mSize - mPos)
+			throw std::invalid_argument("truncated WKB geometry.");
+	}
+
+	uint8_t readByte() {
+		require(1);
+		return mData[mPos++];
+	}
+
+	template <typename T>
+	T read(bool bigEndian) {
+		require(sizeof(T));
+		uint8_t bytes[sizeof(T)];
+		std::memcpy(bytes, mData + mPos, sizeof(T));
+		mPos += sizeof(T);
+		if (bigEndian != HOST_BIG_ENDIAN)
+			std::reverse(bytes, bytes + sizeof(T));
+		T value;
+		std::memcpy(&value, bytes, sizeof(T));
+		return value;
+	}
+
+	uint32_t readUInt32(bool bigEndian) {
+		return read<uint32_t>(bigEndian);
+	}
+
+	double readDouble(bool bigEndian) {
+		return read<double>(bigEndian);
+	}
+
+	static const bool HOST_BIG_ENDIAN;
+
+	const uint8_t* mData;
+	const size_t mSize;
+	size_t mPos = 0;
+};
+
+const bool Parser::HOST_BIG_ENDIAN = [] {
+	const uint16_t value = 1;
+	uint8_t firstByte;
+	std::memcpy(&firstByte, &value, 1);
+	return firstByte == 0;
+}();
+
+} // namespace
+
+/**
+ * Parses the geometries on up to numThreads threads (0 means all hardware threads) and concatenates them in order.
+ * Each polygon becomes one face, the interior rings become its holes.
+ */
+InitialShapeBatch WKBReader::read(const std::vector<Buffer>& geometries, size_t numThreads) {
+	std::vector<Polygons> parsed(geometries.size());
+
+	const size_t unitCount = (geometries.size() + GEOMETRIES_PER_WORK_UNIT - 1) / GEOMETRIES_PER_WORK_UNIT;
+	pcu::parallelFor(unitCount, pcu::getThreadCount(numThreads), [&](size_t unit) {
+		const size_t first = unit * GEOMETRIES_PER_WORK_UNIT;
+		const size_t last = std::min(first + GEOMETRIES_PER_WORK_UNIT, geometries.size());
+		for (size_t g = first; g < last; g++) {
+			try {
+				Parser parser(geometries[g].first, geometries[g].second);
+				parser.readGeometry(parsed[g], false);
+				if (!parser.atEnd())
+					throw std::invalid_argument("unexpected trailing bytes.");
+			}
+			catch (const std::invalid_argument& e) {
+				throw std::invalid_argument("invalid WKB geometry at index " + std::to_string(g) + ": " + e.what());
+			}
+		}
+	});
+
+	size_t coordinateCount = 0;
+	size_t ringCount = 0;
+	size_t polygonCount = 0;
+	for (const Polygons& p : parsed) {
+		coordinateCount += p.mCoordinates.size();
+		ringCount += p.mRingSizes.size();
+		polygonCount += p.mPolygonRingCounts.size();
+	}
+
+	Coordinates coordinates;
+	InitialShapeBatch::Offsets ringOffsets;
+	InitialShapeBatch::Offsets polygonOffsets;
+	InitialShapeBatch::Offsets shapeOffsets;
+	coordinates.reserve(coordinateCount);
+	ringOffsets.reserve(ringCount + 1);
+	polygonOffsets.reserve(polygonCount + 1);
+	shapeOffsets.reserve(parsed.size() + 1);
+	ringOffsets.push_back(0);
+	polygonOffsets.push_back(0);
+	shapeOffsets.push_back(0);
+
+	for (Polygons& p : parsed) {
+		coordinates.insert(coordinates.end(), p.mCoordinates.begin(), p.mCoordinates.end());
+		for (uint64_t ringSize : p.mRingSizes)
+			ringOffsets.push_back(ringOffsets.back() + ringSize);
+		for (uint64_t polygonRingCount : p.mPolygonRingCounts)
+			polygonOffsets.push_back(polygonOffsets.back() + polygonRingCount);
+		shapeOffsets.push_back(shapeOffsets.back() + p.mPolygonRingCounts.size());
+		p = Polygons();
+	}
+
+	return InitialShapeBatch::fromPolygons(coordinates, 3, ringOffsets, polygonOffsets, shapeOffsets);
+}
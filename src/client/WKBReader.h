@@ -0,0 +1,37 @@
+/**
+ * PyPRT - Python Bindings for the Procedural Runtime (PRT) of CityEngine
+ *
+ * Copyright (c) 2012-2022 Esri R&D Center Zurich
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * A copy of the license is available in the repository's LICENSE file.
+ */
+
+#pragma once
+
+#include "InitialShapeBatch.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * Reads Polygon and MultiPolygon geometries in WKB and EWKB (with Z, M and SRID) encoding into an initial shape batch,
+ * one shape per geometry.
+ */
+class WKBReader {
+public:
+	using Buffer = std::pair<const uint8_t*, size_t>;
+
+	static InitialShapeBatch read(const std::vector<Buffer>& geometries, size_t numThreads);
+};
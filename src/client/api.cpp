@@ -21,9 +21,22 @@
 #	define _CRT_SECURE_NO_WARNINGS
 #endif
 
+#include "ArrowExport.h"
+#include "AttributeMapCache.h"
+#include "CachePool.h"
+#include "ColumnOutput.h"
+#include "EncoderOptionsCache.h"
+#include "GeometryCache.h"
+#include "GeneratedModelIterator.h"
 #include "InitialShape.h"
+#include "InitialShapeBatch.h"
 #include "ModelGenerator.h"
 #include "PRTContext.h"
+#include "RuleInfo.h"
+#include "RulePackageCache.h"
+#include "ShapeAttributes.h"
+#include "ThreadPool.h"
+#include "WKBReader.h"
 #include "doc.h"
 #include "logging.h"
 #include "utils.h"
@@ -35,6 +48,8 @@
 
 #include <cstdio>
 #include <filesystem>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 #ifdef _WIN32
@@ -45,7 +60,6 @@ namespace py = pybind11;
 
 namespace {
 
-constexpr const wchar_t* ANNOT_HIDDEN = L"@Hidden";
 constexpr const wchar_t* NO_KEY = L"#NULL#";
 
 void initializePRT() {
@@ -62,45 +76,32 @@ void shutdownPRT() {
 	PRTContext::shutdown();
 }
 
-void getAnnotations(const prt::RuleFileInfo::Entry* attribute, std::vector<std::vector<py::object>>& annotations,
-                    bool& hidden) {
-	for (size_t f = 0; f < attribute->getNumAnnotations(); f++) {
-		const prt::Annotation* annot = attribute->getAnnotation(f);
-		if (std::wcscmp(annot->getName(), ANNOT_HIDDEN) == 0) {
-			hidden = true;
-			break;
+py::list getAnnotations(const RuleInfo::Attribute& attribute) {
+	py::list annotations;
+	for (const RuleInfo::Annotation& annot : attribute.mAnnotations) {
+		py::list annotationPyList;
+		annotationPyList.append(py::cast(annot.mName));
+
+		for (const RuleInfo::AnnotationArgument& annotationArg : annot.mArguments) {
+			py::object annotationValue;
+			if (annotationArg.mType == prt::AAT_STR)
+				annotationValue = py::cast(annotationArg.mString);
+			else if (annotationArg.mType == prt::AAT_BOOL)
+				annotationValue = py::cast(annotationArg.mBool);
+			else if (annotationArg.mType == prt::AAT_FLOAT)
+				annotationValue = py::cast(annotationArg.mFloat);
+			else
+				annotationValue = py::cast("UNKNOWN_PARAMETER_VALUE_TYPE");
+
+			py::list annotationParameters;
+			annotationParameters.append(py::cast(annotationArg.mKey));
+			annotationParameters.append(annotationValue);
+			annotationPyList.append(annotationParameters);
 		}
 
-		if (std::wcsncmp(annot->getName(), L"@", 1) == 0) {
-			std::vector<py::object> annotationPyList;
-			annotationPyList.push_back(py::cast(annot->getName()));
-
-			for (size_t u = 0; u < annot->getNumArguments(); u++) {
-				py::object annotationValue;
-				const prt::AnnotationArgument* annotationArg = annot->getArgument(u);
-				const prt::AnnotationArgumentType annotationValueType = annotationArg->getType();
-
-				if (annotationValueType == prt::AAT_STR)
-					annotationValue = py::cast(annotationArg->getStr());
-				else if (annotationValueType == prt::AAT_BOOL)
-					annotationValue = py::cast(annotationArg->getBool());
-				else if (annotationValueType == prt::AAT_FLOAT)
-					annotationValue = py::cast(annotationArg->getFloat());
-				else
-					annotationValue = py::cast("UNKNOWN_PARAMETER_VALUE_TYPE");
-
-				py::list annotationParameters;
-				if (std::wcscmp(annotationArg->getKey(), NO_KEY) == 0)
-					annotationParameters.append(py::cast(NO_KEY));
-				else
-					annotationParameters.append(py::cast(annotationArg->getKey()));
-				annotationParameters.append(annotationValue);
-				annotationPyList.push_back(annotationParameters);
-			}
-
-			annotations.push_back(annotationPyList);
-		}
+		annotations.append(annotationPyList);
 	}
+	return annotations;
 }
 
 py::str getAnnotationArgumentTypeString(const prt::AnnotationArgumentType& valueType) {
@@ -122,59 +123,355 @@ py::str getAnnotationArgumentTypeString(const prt::AnnotationArgumentType& value
 	return type;
 }
 
-py::dict getRuleAttributes(const prt::RuleFileInfo* ruleFileInfo) {
+py::dict getRuleAttributes(const RuleInfo& ruleInfo) {
 	auto ruleAttrs = py::dict();
 
-	for (size_t i = 0; i < ruleFileInfo->getNumAttributes(); i++) {
-		const prt::RuleFileInfo::Entry* attr = ruleFileInfo->getAttribute(i);
-		bool hidden = false;
-		std::vector<std::vector<py::object>> annotations;
-		const std::wstring fullName(attr->getName());
-		if (fullName.find(L"Default$") != 0)
-			continue;
-		if (attr->getNumParameters() > 0)
-			continue;
-		const std::wstring name = fullName.substr(8);
-		getAnnotations(attr, annotations, hidden);
-
-		const prt::AnnotationArgumentType valueType = attr->getReturnType();
+	for (const RuleInfo::Attribute& attr : ruleInfo.getAttributes()) {
 		auto dictAttr = py::dict();
-		if (!hidden) {
-			dictAttr[py::cast("type")] = getAnnotationArgumentTypeString(valueType);
-			dictAttr[py::cast("annotations")] = annotations;
-			ruleAttrs[py::cast(name)] = dictAttr;
-		}
+		dictAttr[py::cast("type")] = getAnnotationArgumentTypeString(attr.mType);
+		dictAttr[py::cast("annotations")] = getAnnotations(attr);
+		ruleAttrs[py::cast(attr.mName)] = dictAttr;
 	}
 
 	return ruleAttrs;
 }
 
-py::dict getRPKInfo(const std::filesystem::path& rulePackagePath) {
-	ResolveMapPtr resolveMap;
+py::set getHiddenAttributes(const RuleInfo& ruleInfo) {
+	py::set hiddenAttrs;
+	for (const std::wstring& attr : ruleInfo.getHiddenAttributes())
+		hiddenAttrs.add(pcu::removeDefaultStyleName(attr.c_str()));
+	return hiddenAttrs;
+}
 
-	if (!std::filesystem::exists(rulePackagePath) || !pcu::getResolveMap(rulePackagePath, &resolveMap)) {
+std::shared_ptr<RuleInfo> getRuleInfo(const std::filesystem::path& rulePackagePath) {
+	RuleInfoPtr ruleInfo;
+	{
+		// loading the rule package may take long, e.g. while another process unpacks it
+		py::gil_scoped_release release;
+		if (std::filesystem::exists(rulePackagePath))
+			ruleInfo = RulePackageCache::get().getRuleInfo(rulePackagePath);
+	}
+	if (!ruleInfo)
 		LOG_ERR << "invalid rule package path";
+
+	// rule infos are immutable, the python binding only exposes const member functions
+	return std::const_pointer_cast<RuleInfo>(ruleInfo);
+}
+
+py::dict getRPKInfo(const std::filesystem::path& rulePackagePath) {
+	const auto ruleInfo = getRuleInfo(rulePackagePath);
+	if (!ruleInfo)
 		return py::dict();
+
+	return getRuleAttributes(*ruleInfo);
+}
+
+py::dict getRulePackageCacheStats() {
+	const RulePackageCache& cache = RulePackageCache::get();
+	py::dict stats;
+	stats["hits"] = cache.getHitCount();
+	stats["misses"] = cache.getMissCount();
+	stats["entries"] = cache.getEntryCount();
+	stats["rule_info_reads"] = cache.getRuleInfoReadCount();
+	stats["rule_info_writes"] = cache.getRuleInfoWriteCount();
+	return stats;
+}
+
+void clearRulePackageCache() {
+	RulePackageCache::get().clear();
+}
+
+void setRPKUnpackDirectory(const std::string& unpackDirectory) {
+	RulePackageCache::get().setUnpackDirectory(unpackDirectory);
+}
+
+std::string getRPKUnpackDirectory() {
+	return RulePackageCache::get().getUnpackDirectory().string();
+}
+
+py::dict getAttributeMapCacheStats() {
+	const AttributeMapCache& cache = AttributeMapCache::get();
+	py::dict stats;
+	stats["hits"] = cache.getHitCount();
+	stats["misses"] = cache.getMissCount();
+	stats["entries"] = cache.getEntryCount();
+	stats["capacity"] = cache.getCapacity();
+	return stats;
+}
+
+void setAttributeMapCacheCapacity(size_t capacity) {
+	AttributeMapCache::get().setCapacity(capacity);
+}
+
+void clearAttributeMapCache() {
+	AttributeMapCache::get().clear();
+}
+
+py::dict getEncoderOptionsCacheStats() {
+	const EncoderOptionsCache& cache = EncoderOptionsCache::get();
+	py::dict stats;
+	stats["hits"] = cache.getHitCount();
+	stats["misses"] = cache.getMissCount();
+	stats["entries"] = cache.getEntryCount();
+	return stats;
+}
+
+py::dict getGeometryCacheStats() {
+	const GeometryCache& cache = GeometryCache::get();
+	py::dict stats;
+	stats["hits"] = cache.getHitCount();
+	stats["misses"] = cache.getMissCount();
+	stats["entries"] = cache.getEntryCount();
+	stats["bytes"] = cache.getByteCount();
+	stats["budget"] = cache.getBudget();
+	return stats;
+}
+
+void setGeometryCacheBudget(uintmax_t budget) {
+	GeometryCache::get().setBudget(budget);
+}
+
+void clearGeometryCache() {
+	GeometryCache::get().clear();
+}
+
+// the natively decoded initial shape files are part of the shared cache from the user's point of view
+py::dict getCacheStats() {
+	const CachePool& pool = CachePool::get();
+	const GeometryCache& geometryCache = GeometryCache::get();
+	py::dict stats;
+	stats["bytes"] = pool.getByteCount() + geometryCache.getByteCount();
+	stats["entries"] = pool.getEntryCount() + geometryCache.getEntryCount();
+	stats["budget"] = pool.getBudget();
+	stats["flushes"] = pool.getFlushCount();
+	return stats;
+}
+
+void setCacheBudget(uintmax_t budget) {
+	CachePool::get().setBudget(budget);
+}
+
+void flushCache() {
+	CachePool::get().flush();
+	GeometryCache::get().clear();
+}
+
+void flushCacheEntry(const std::string& uri) {
+	// accept plain file paths, they are cached under their file URI or decoded in the geometry cache
+	const bool isPath = std::filesystem::exists(uri);
+	if (isPath)
+		GeometryCache::get().flushEntry(uri);
+	const std::string fileURI = isPath ? pcu::toFileURI(std::filesystem::canonical(uri).string()) : uri;
+	CachePool::get().flushEntry(pcu::toUTF16FromOSNarrow(fileURI));
+}
+
+// buffers of any numeric type are converted natively, C-contiguous ones of the matching type are copied as a whole
+InitialShape createInitialShapeFromBuffer(const py::buffer& vertCoordinates) {
+	return InitialShape(pcu::toVector<double>(vertCoordinates));
+}
+
+InitialShape createInitialShapeFromBuffers(const py::buffer& vertCoordinates, const py::buffer& faceVertIndices,
+                                           const py::buffer& faceVertCount, const HoleIndices& holes) {
+	return InitialShape(pcu::toVector<double>(vertCoordinates), pcu::toVector<uint32_t>(faceVertIndices),
+	                    pcu::toVector<uint32_t>(faceVertCount), holes);
+}
+
+InitialShapeBatch createInitialShapeBatch(const py::object& vertCoordinates, const py::object& faceVertIndices,
+                                          const py::object& faceVertCount, const py::object& vertexOffsets,
+                                          const py::object& indexOffsets, const py::object& faceCountOffsets,
+                                          const py::object& holes, const py::object& holeOffsets) {
+	InitialShapeBatch::Buffers buffers;
+	buffers.mVertices = pcu::toVector<double>(vertCoordinates);
+	buffers.mIndices = pcu::toVector<uint32_t>(faceVertIndices);
+	buffers.mFaceCounts = pcu::toVector<uint32_t>(faceVertCount);
+	buffers.mVertexOffsets = pcu::toVector<uint64_t>(vertexOffsets);
+	buffers.mIndexOffsets = pcu::toVector<uint64_t>(indexOffsets);
+	buffers.mFaceCountOffsets = pcu::toVector<uint64_t>(faceCountOffsets);
+	if (!holes.is_none())
+		buffers.mHoles = pcu::toVector<uint32_t>(holes);
+	if (!holeOffsets.is_none())
+		buffers.mHoleOffsets = pcu::toVector<uint64_t>(holeOffsets);
+	return InitialShapeBatch(std::move(buffers));
+}
+
+InitialShapeBatch createInitialShapeBatchFromRings(const py::object& coordinates, const py::object& ringOffsets,
+                                                   const py::object& shapeOffsets, size_t dimensions) {
+	const Coordinates coords = pcu::toVector<double>(coordinates);
+	const InitialShapeBatch::Offsets rings = pcu::toVector<uint64_t>(ringOffsets);
+	const InitialShapeBatch::Offsets shapes = pcu::toVector<uint64_t>(shapeOffsets);
+
+	py::gil_scoped_release release;
+	return InitialShapeBatch::fromRings(coords, dimensions, rings, shapes);
+}
+
+InitialShapeBatch createInitialShapeBatchFromWKB(const py::iterable& geometries, size_t numThreads) {
+	// the buffer views keep the geometries alive and are released with the GIL held
+	std::vector<py::buffer_info> views;
+	std::vector<WKBReader::Buffer> buffers;
+	for (const py::handle geometry : geometries) {
+		views.push_back(py::reinterpret_borrow<py::buffer>(geometry).request());
+		buffers.emplace_back(static_cast<const uint8_t*>(views.back().ptr),
+		                     static_cast<size_t>(views.back().size * views.back().itemsize));
 	}
 
-	std::wstring ruleFile = pcu::getRuleFileEntry(resolveMap.get());
+	py::gil_scoped_release release;
+	return WKBReader::read(buffers, numThreads);
+}
 
-	const wchar_t* ruleFileURI = resolveMap->getString(ruleFile.c_str());
-	if (ruleFileURI == nullptr) {
-		LOG_ERR << "could not find rule file URI in resolve map of rule package " << rulePackagePath;
-		return py::dict();
+InitialShapeBatch createInitialShapeBatchFromFile(const std::string& path) {
+	GeometryCache::GeometryPtr geometry;
+	{
+		py::gil_scoped_release release;
+		geometry = GeometryCache::get().getGeometry(path, true);
 	}
+	if (!geometry)
+		throw std::invalid_argument("could not read initial shape geometry from '" + path + "'.");
+	return geometry->mShapes;
+}
 
-	prt::Status infoStatus = prt::STATUS_UNSPECIFIED_ERROR;
-	RuleFileInfoUPtr info(prt::createRuleFileInfo(ruleFileURI, nullptr, &infoStatus));
-	if (!info || infoStatus != prt::STATUS_OK) {
-		LOG_ERR << "could not get rule file info from rule file " << ruleFile;
-		return py::dict();
+InitialShapeBatch sliceInitialShapeBatch(const InitialShapeBatch& batch, const py::slice& slice) {
+	size_t start = 0, stop = 0, step = 0, length = 0;
+	if (!slice.compute(batch.size(), &start, &stop, &step, &length))
+		throw py::error_already_set();
+	if (step != 1)
+		throw std::invalid_argument("initial shape batches can only be sliced with a step of 1.");
+	return batch.slice(start, length);
+}
+
+// concurrent.futures.Future subclass which can also be awaited, kept alive by the module attribute
+py::handle generateModelFutureType;
+
+py::object createGenerateModelFutureType(const py::module& m) {
+	const py::object futureBase = py::module::import("concurrent.futures").attr("Future");
+	py::dict members;
+	members["__doc__"] = doc::GenerateModelFuture;
+	members["__module__"] = m.attr("__name__");
+	py::object futureType =
+	        py::module::import("builtins").attr("type")("GenerateModelFuture", py::make_tuple(futureBase), members);
+
+	futureType.attr("__await__") = py::cpp_function(
+	        [](py::object self) {
+		        const py::object asyncioFuture = py::module::import("asyncio").attr("wrap_future")(self);
+		        return asyncioFuture.attr("__await__")();
+	        },
+	        py::name("__await__"), py::is_method(futureType));
+	return futureType;
+}
+
+// a dict of columns or a list of dicts, one per initial shape or one for all of them
+ShapeAttributes toShapeAttributes(const py::object& shapeAttributes, const ModelGenerator& generator) {
+	if (py::isinstance<py::dict>(shapeAttributes))
+		return ShapeAttributes(py::reinterpret_borrow<py::dict>(shapeAttributes), generator.getInitialShapeCount());
+	return ShapeAttributes(shapeAttributes.cast<std::vector<py::dict>>());
+}
+
+// an encoder ID or a list of them, with a dict of options for all of them or a list of dicts, one per encoder
+GeometryEncoders toGeometryEncoders(const py::object& encoderNames, const py::object& encoderOptions) {
+	const std::vector<std::wstring> names = py::isinstance<py::str>(encoderNames)
+	                                                ? std::vector<std::wstring>{encoderNames.cast<std::wstring>()}
+	                                                : encoderNames.cast<std::vector<std::wstring>>();
+	if (names.empty())
+		throw std::invalid_argument("at least one geometry encoder is required");
+
+	GeometryEncoders encoders;
+	encoders.reserve(names.size());
+	if (py::isinstance<py::dict>(encoderOptions)) {
+		const py::dict options = py::reinterpret_borrow<py::dict>(encoderOptions);
+		for (const std::wstring& name : names)
+			encoders.push_back({name, options});
+		return encoders;
 	}
 
-	py::dict ruleAttrs = getRuleAttributes(info.get());
+	const std::vector<py::dict> options = encoderOptions.cast<std::vector<py::dict>>();
+	if (options.size() != names.size())
+		throw std::invalid_argument("got " + std::to_string(options.size()) + " encoder options for " +
+		                            std::to_string(names.size()) + " geometry encoders");
+	for (size_t i = 0; i < names.size(); i++)
+		encoders.push_back({names[i], options[i]});
+	validateGeometryEncoders(encoders);
+	return encoders;
+}
 
-	return ruleAttrs;
+std::vector<GeneratedModel> generateModel(ModelGenerator& generator, const py::object& shapeAttributes,
+                                          const std::filesystem::path& rulePackagePath,
+                                          const py::object& geometryEncoderName,
+                                          const py::object& geometryEncoderOptions, size_t numThreads) {
+	return generator.generateModel(toShapeAttributes(shapeAttributes, generator), rulePackagePath,
+	                               toGeometryEncoders(geometryEncoderName, geometryEncoderOptions), numThreads);
+}
+
+struct AsyncGenerateJob {
+	py::object mFuture;
+	py::object mGenerator;
+	std::optional<ShapeAttributes> mShapeAttributes;
+	std::filesystem::path mRulePackagePath;
+	GeometryEncoders mGeometryEncoders;
+	size_t mNumThreads = 1;
+};
+
+/**
+ * Runs generateModel on the native thread pool. The job holds Python objects, so it is only touched and released
+ * with the GIL held. Futures cancelled before a worker picks them up are skipped.
+ */
+py::object generateModelAsync(py::object generator, const py::object& shapeAttributes,
+                              const std::filesystem::path& rulePackagePath, const py::object& geometryEncoderName,
+                              const py::object& geometryEncoderOptions, size_t numThreads) {
+	py::object future = generateModelFutureType();
+
+	auto job = std::make_shared<AsyncGenerateJob>();
+	job->mFuture = future;
+	job->mGenerator = generator;
+	job->mShapeAttributes = toShapeAttributes(shapeAttributes, generator.cast<const ModelGenerator&>());
+	job->mRulePackagePath = rulePackagePath;
+	job->mGeometryEncoders = toGeometryEncoders(geometryEncoderName, geometryEncoderOptions);
+	job->mNumThreads = numThreads;
+
+	const bool submitted = ThreadPool::get().submit([job]() mutable {
+		py::gil_scoped_acquire acquire;
+		if (job->mFuture.attr("set_running_or_notify_cancel")().cast<bool>()) {
+			try {
+				ModelGenerator& modelGenerator = job->mGenerator.cast<ModelGenerator&>();
+				std::vector<GeneratedModel> models =
+				        modelGenerator.generateModel(*job->mShapeAttributes, job->mRulePackagePath,
+				                                     job->mGeometryEncoders, job->mNumThreads);
+				job->mFuture.attr("set_result")(py::cast(std::move(models)));
+			}
+			catch (py::error_already_set& e) {
+				job->mFuture.attr("set_exception")(e.value());
+			}
+			catch (const std::exception& e) {
+				job->mFuture.attr("set_exception")(py::module::import("builtins").attr("RuntimeError")(e.what()));
+			}
+		}
+		job.reset();
+	});
+
+	if (!submitted) {
+		future.attr("set_running_or_notify_cancel")();
+		future.attr("set_exception")(py::module::import("builtins").attr("RuntimeError")("PyPRT is shutting down"));
+	}
+	return future;
+}
+
+std::unique_ptr<GeneratedModelIterator> generateModelIter(py::object generator, const py::object& shapeAttributes,
+                                                          const std::filesystem::path& rulePackagePath,
+                                                          const py::object& geometryEncoderName,
+                                                          const py::object& geometryEncoderOptions, size_t batchSize,
+                                                          size_t maxBatchesInFlight, size_t numThreads) {
+	ShapeAttributes attributes = toShapeAttributes(shapeAttributes, generator.cast<const ModelGenerator&>());
+	return std::make_unique<GeneratedModelIterator>(std::move(generator), std::move(attributes), rulePackagePath,
+	                                                toGeometryEncoders(geometryEncoderName, geometryEncoderOptions),
+	                                                numThreads, batchSize, maxBatchesInFlight);
+}
+
+void shutdownThreadPool() {
+	std::vector<ThreadPool::Task> pendingTasks;
+	{
+		// running tasks need the GIL to finish
+		py::gil_scoped_release release;
+		pendingTasks = ThreadPool::get().stop();
+	}
+	pendingTasks.clear(); // the tasks hold Python objects
 }
 
 } // namespace
@@ -184,15 +481,54 @@ PYBIND11_MODULE(pyprt, m) {
 	py::options options;
 	options.disable_function_signatures();
 
-	py::bind_vector<std::vector<GeneratedModel>>(m, "GeneratedModelVector", py::module_local(false));
+	py::bind_vector<std::vector<GeneratedModel>>(m, "GeneratedModelVector", py::module_local(false))
+	        .def(
+	                "__arrow_c_stream__",
+	                [](const std::vector<GeneratedModel>& models, const py::object& /*requestedSchema*/) {
+		                return exportArrowStream(models);
+	                },
+	                py::arg("requested_schema") = py::none(), doc::GmvArrowStream)
+	        .def("get_attribute_columns", &getAttributeColumns, doc::GmvGetAttrColumns)
+	        .def("get_report_columns", &getReportColumns, doc::GmvGetReportColumns);
 
 	m.def("initialize_prt", &initializePRT, doc::Init);
 	m.def("is_prt_initialized", &isPRTInitialized, doc::IsInit);
 	m.def("shutdown_prt", &shutdownPRT, doc::Shutdown);
 	m.def("get_rpk_attributes_info", &getRPKInfo, py::arg("rulePackagePath"), doc::GetRPKInfo);
+	m.def("get_rule_info", &getRuleInfo, py::arg("rulePackagePath"), doc::GetRuleInfo);
+	m.def("get_rule_package_cache_stats", &getRulePackageCacheStats, doc::GetRPKCacheStats);
+	m.def("clear_rule_package_cache", &clearRulePackageCache, doc::ClearRPKCache);
+	m.def("set_rpk_unpack_directory", &setRPKUnpackDirectory, py::arg("unpackDirectory"), doc::SetRPKUnpackDir);
+	m.def("get_rpk_unpack_directory", &getRPKUnpackDirectory, doc::GetRPKUnpackDir);
+	m.def("get_attribute_map_cache_stats", &getAttributeMapCacheStats, doc::GetAttrMapCacheStats);
+	m.def("set_attribute_map_cache_capacity", &setAttributeMapCacheCapacity, py::arg("capacity"),
+	      doc::SetAttrMapCacheCapacity);
+	m.def("clear_attribute_map_cache", &clearAttributeMapCache, doc::ClearAttrMapCache);
+	m.def("get_encoder_options_cache_stats", &getEncoderOptionsCacheStats, doc::GetEncOptCacheStats);
+	m.def("get_geometry_cache_stats", &getGeometryCacheStats, doc::GetGeoCacheStats);
+	m.def("set_geometry_cache_budget", &setGeometryCacheBudget, py::arg("budget"), doc::SetGeoCacheBudget);
+	m.def("clear_geometry_cache", &clearGeometryCache, doc::ClearGeoCache);
+	m.def("get_cache_stats", &getCacheStats, doc::GetCacheStats);
+	m.def("set_cache_budget", &setCacheBudget, py::arg("budget"), doc::SetCacheBudget);
+	m.def("flush_cache", &flushCache, doc::FlushCache);
+	m.def("flush_cache_entry", &flushCacheEntry, py::arg("uri"), doc::FlushCacheEntry);
 	m.attr("NO_KEY") = NO_KEY;
 
+	m.attr("GenerateModelFuture") = createGenerateModelFutureType(m);
+	generateModelFutureType = m.attr("GenerateModelFuture");
+	py::module::import("atexit").attr("register")(py::cpp_function(&shutdownThreadPool));
+
+	py::class_<RuleInfo, std::shared_ptr<RuleInfo>>(m, "RuleInfo", doc::Ri)
+	        .def("get_rule_file", &RuleInfo::getRuleFile, doc::RiGetRuleFile)
+	        .def("get_start_rule", &RuleInfo::getStartRule, doc::RiGetStartRule)
+	        .def("get_hidden_attributes", &getHiddenAttributes, doc::RiGetHidden)
+	        .def("get_attributes_info", &getRuleAttributes, doc::RiGetAttrs);
+
+	// the buffer overloads come first so NumPy arrays are not converted element by element by the list overloads
 	py::class_<InitialShape>(m, "InitialShape", doc::Is)
+	        .def(py::init(&createInitialShapeFromBuffer), py::arg("vertCoordinates"), doc::IsInitVB)
+	        .def(py::init(&createInitialShapeFromBuffers), py::arg("vertCoordinates"), py::arg("faceVertIndices"),
+	             py::arg("faceVertCount"), py::arg("holes") = HoleIndices(), doc::IsInitVIB)
 	        .def(py::init<const Coordinates&>(), py::arg("vertCoordinates"), doc::IsInitV)
 	        .def(py::init<const Coordinates&, const Indices&, const Indices&, const HoleIndices&>(),
 	             py::arg("vertCoordinates"), py::arg("faceVertIndices"), py::arg("faceVertCount"),
@@ -203,17 +539,45 @@ PYBIND11_MODULE(pyprt, m) {
 	        .def("get_face_counts_count", &InitialShape::getFaceCountsCount, doc::IsGetF)
 	        .def("get_path", &InitialShape::getPath, doc::IsGetP);
 
+	py::class_<InitialShapeBatch>(m, "InitialShapeBatch", doc::Isb)
+	        .def(py::init(&createInitialShapeBatch), py::arg("vertCoordinates"), py::arg("faceVertIndices"),
+	             py::arg("faceVertCount"), py::arg("vertexOffsets"), py::arg("indexOffsets"),
+	             py::arg("faceCountOffsets"), py::arg("holes") = py::none(), py::arg("holeOffsets") = py::none())
+	        .def_static("from_rings", &createInitialShapeBatchFromRings, py::arg("coordinates"),
+	                    py::arg("ringOffsets"), py::arg("shapeOffsets"), py::arg("dimensions") = 2, doc::IsbFromRings)
+	        .def_static("from_wkb", &createInitialShapeBatchFromWKB, py::arg("geometries"), py::arg("numThreads") = 0,
+	                    doc::IsbFromWKB)
+	        .def_static("from_file", &createInitialShapeBatchFromFile, py::arg("path"), doc::IsbFromFile)
+	        .def("__len__", &InitialShapeBatch::size)
+	        .def("__getitem__", &sliceInitialShapeBatch, py::arg("slice"))
+	        .def("get_vertex_count", &InitialShapeBatch::getVertexCount, doc::IsbGetV);
+
 	py::class_<ModelGenerator>(m, "ModelGenerator", doc::Mg)
-	        .def(py::init<const std::vector<InitialShape>&>(), py::arg("initialShapes"), doc::MgInit)
-	        .def("generate_model", &ModelGenerator::generateModel, py::arg("shapeAttributes"),
+	        .def(py::init<const std::vector<InitialShape>&, size_t>(), py::arg("initialShapes"),
+	             py::arg("numThreads") = 0, doc::MgInit)
+	        .def(py::init<const InitialShapeBatch&, size_t>(), py::arg("initialShapes"), py::arg("numThreads") = 0)
+	        .def("generate_model", &generateModel, py::arg("shapeAttributes"),
 	             py::arg("rulePackagePath"), py::arg("geometryEncoderName"), py::arg("geometryEncoderOptions"),
-	             doc::MgGen);
+	             py::arg("numThreads") = 1, doc::MgGen)
+	        .def("generate_model_async", &generateModelAsync, py::arg("shapeAttributes"), py::arg("rulePackagePath"),
+	             py::arg("geometryEncoderName"), py::arg("geometryEncoderOptions"), py::arg("numThreads") = 1,
+	             doc::MgGenAsync)
+	        .def("generate_model_iter", &generateModelIter, py::arg("shapeAttributes"), py::arg("rulePackagePath"),
+	             py::arg("geometryEncoderName"), py::arg("geometryEncoderOptions"), py::arg("batchSize") = 256,
+	             py::arg("maxBatchesInFlight") = 2, py::arg("numThreads") = 1, doc::MgGenIter);
+
+	py::class_<GeneratedModelIterator>(m, "GeneratedModelIterator", doc::Gmi)
+	        .def("__iter__", [](py::object self) { return self; })
+	        .def("__next__", &GeneratedModelIterator::next);
 
 	py::class_<GeneratedModel>(m, "GeneratedModel", doc::Gm)
 	        .def("get_initial_shape_index", &GeneratedModel::getInitialShapeIndex, doc::GmGetInd)
 	        .def("get_vertices", &GeneratedModel::getVertices, doc::GmGetV)
 	        .def("get_indices", &GeneratedModel::getIndices, doc::GmGetI)
 	        .def("get_faces", &GeneratedModel::getFaces, doc::GmGetF)
+	        .def("get_vertices_array", &GeneratedModel::getVerticesArray, doc::GmGetVArray)
+	        .def("get_indices_array", &GeneratedModel::getIndicesArray, doc::GmGetIArray)
+	        .def("get_faces_array", &GeneratedModel::getFacesArray, doc::GmGetFArray)
 	        .def("get_report", &GeneratedModel::getReport, doc::GmGetR)
 	        .def("get_cga_prints", &GeneratedModel::getCGAPrints, doc::GmGetP)
 	        .def("get_cga_errors", &GeneratedModel::getCGAErrors, doc::GmGetE)
@@ -59,15 +59,244 @@ constexpr const char* GetRPKInfo = R"mydelimiter(
             dict
     )mydelimiter";
 
+constexpr const char* GetRuleInfo = R"mydelimiter(
+        get_rule_info(rule_package_path) -> RuleInfo
+
+        This function returns the :py:class:`RuleInfo <pyprt.pyprt.bin.pyprt.RuleInfo>` of the specified rule package.
+        The rule info is computed once per rule package and shared with the model generation. Returns *None* if
+        the rule package is invalid.
+
+        :Returns:
+            RuleInfo
+    )mydelimiter";
+
+constexpr const char* GetRPKCacheStats = R"mydelimiter(
+        get_rule_package_cache_stats() -> dict
+
+        Rule packages are resolved once per process and then shared by all :py:class:`ModelGenerator <pyprt.pyprt.bin.pyprt.ModelGenerator>`
+        instances and ``get_rpk_attributes_info`` calls. A cached rule package is reloaded automatically as soon as the
+        size or the modification time of its file changes. This function returns the ``'hits'``, ``'misses'`` and
+        ``'entries'`` counters of that cache. With an unpack directory, ``'rule_info_reads'`` and ``'rule_info_writes'``
+        count the rule infos read from and written to it.
+
+        :Returns:
+            dict
+    )mydelimiter";
+
+constexpr const char* ClearRPKCache = R"mydelimiter(
+        clear_rule_package_cache()
+
+        Removes all rule packages from the process-wide rule package cache. The hit and miss counters are kept.
+    )mydelimiter";
+
+constexpr const char* SetRPKUnpackDir = R"mydelimiter(
+        set_rpk_unpack_directory(unpack_directory)
+
+        Sets a persistent directory into which rule packages are unpacked. Each rule package is extracted once into a
+        sub-directory named after its content hash and reused by all later processes using the same directory, which
+        avoids unpacking the rule package again in every new process. Concurrent first use by several processes is
+        safe. An empty string disables the persistent directory (default). The initial value can also be provided with
+        the ``PYPRT_RPK_UNPACK_DIR`` environment variable. Rule packages already in the rule package cache are not
+        affected, see ``clear_rule_package_cache``.
+
+        :Parameters:
+            **unpack_directory** -- str
+    )mydelimiter";
+
+constexpr const char* GetRPKUnpackDir = R"mydelimiter(
+        get_rpk_unpack_directory() -> str
+
+        Returns the persistent rule package unpack directory, or an empty string if none is set.
+
+        :Returns:
+            str
+    )mydelimiter";
+
+constexpr const char* GetAttrMapCacheStats = R"mydelimiter(
+        get_attribute_map_cache_stats() -> dict
+
+        Shape attribute dicts are converted once per distinct content and the converted attributes are reused across
+        initial shapes and generate calls. This function returns the ``'hits'``, ``'misses'``, ``'entries'`` and
+        ``'capacity'`` counters of that cache. Columnar shape attributes do not go through the cache.
+
+        :Returns:
+            dict
+    )mydelimiter";
+
+constexpr const char* SetAttrMapCacheCapacity = R"mydelimiter(
+        set_attribute_map_cache_capacity(capacity)
+
+        Sets the maximum number of distinct shape attribute dicts kept in the attribute map cache (default 1024). The
+        least recently used entries are dropped first. A capacity of 0 disables the cache.
+
+        :Parameters:
+            **capacity** -- int
+    )mydelimiter";
+
+constexpr const char* ClearAttrMapCache = R"mydelimiter(
+        clear_attribute_map_cache()
+
+        Removes all entries from the attribute map cache. The hit and miss counters are kept.
+    )mydelimiter";
+
+constexpr const char* GetEncOptCacheStats = R"mydelimiter(
+        get_encoder_options_cache_stats() -> dict
+
+        The encoder options of a generate call are validated once per encoder and distinct options, repeated calls reuse
+        the validated options. This function returns the ``'hits'``, ``'misses'`` and ``'entries'`` counters of that
+        cache.
+
+        :Returns:
+            dict
+    )mydelimiter";
+
+constexpr const char* GetGeoCacheStats = R"mydelimiter(
+        get_geometry_cache_stats() -> dict
+
+        OBJ initial shape files are decoded once per process and the decoded geometry is shared by all
+        :py:class:`ModelGenerator <pyprt.pyprt.bin.pyprt.ModelGenerator>` instances and ``InitialShapeBatch.from_file``
+        calls. A cached file is decoded again as soon as its size or modification time changes. This function returns
+        the ``'hits'``, ``'misses'``, ``'entries'``, ``'bytes'`` (decoded geometry) and ``'budget'`` counters of that
+        cache.
+
+        :Returns:
+            dict
+    )mydelimiter";
+
+constexpr const char* SetGeoCacheBudget = R"mydelimiter(
+        set_geometry_cache_budget(budget)
+
+        Sets the memory budget of the geometry cache in bytes (default 256 MiB). Once the decoded geometry exceeds the
+        budget, the least recently used files are dropped from the cache. A budget of 0 disables the limit.
+
+        :Parameters:
+            **budget** -- int
+    )mydelimiter";
+
+constexpr const char* ClearGeoCache = R"mydelimiter(
+        clear_geometry_cache()
+
+        Removes all decoded initial shape files from the geometry cache. The hit and miss counters are kept.
+    )mydelimiter";
+
+constexpr const char* GetCacheStats = R"mydelimiter(
+        get_cache_stats() -> dict
+
+        All :py:class:`ModelGenerator <pyprt.pyprt.bin.pyprt.ModelGenerator>` instances share one process-wide PRT cache
+        for rule packages and initial shape geometry files. This function returns its ``'bytes'`` (estimated from the
+        size of the cached files), ``'entries'``, ``'budget'`` and ``'flushes'`` counters. OBJ initial shape files are
+        decoded by PyPRT itself, ``'bytes'`` and ``'entries'`` include the geometry cache (see
+        ``get_geometry_cache_stats``), whose budget is set separately.
+
+        :Returns:
+            dict
+    )mydelimiter";
+
+constexpr const char* SetCacheBudget = R"mydelimiter(
+        set_cache_budget(budget)
+
+        Sets the memory budget of the shared PRT cache in bytes. Once the estimated size of the cached files exceeds the
+        budget, the least recently used ones are flushed from the cache. A budget of 0 (default) disables the limit.
+
+        :Parameters:
+            **budget** -- int
+    )mydelimiter";
+
+constexpr const char* FlushCache = R"mydelimiter(
+        flush_cache()
+
+        Removes all entries from the shared PRT cache and from the geometry cache. They are loaded again on their next
+        use.
+    )mydelimiter";
+
+constexpr const char* FlushCacheEntry = R"mydelimiter(
+        flush_cache_entry(uri)
+
+        Removes a single resource, e.g. a rule package or an initial shape geometry file, from the shared PRT cache. The
+        decoded geometry of an OBJ file is removed from the geometry cache as well.
+
+        :Parameters:
+            **uri** -- str -- file path or URI of the resource
+    )mydelimiter";
+
+constexpr const char* Ri =
+        "The RuleInfo class holds the rule metadata of a rule package: the rule file, the start rule, the hidden "
+        "attributes and the CGA rule attributes with their types and annotations. Instances are immutable and can be "
+        "reused, use ``get_rule_info`` to obtain one.";
+
+constexpr const char* RiGetRuleFile = R"mydelimiter(
+        get_rule_file() -> str
+
+        Returns the resolve map key of the compiled CGA rule file (e.g. *bin/rule.cgb*).
+
+        :Returns:
+            str
+        )mydelimiter";
+
+constexpr const char* RiGetStartRule = R"mydelimiter(
+        get_start_rule() -> str
+
+        Returns the name of the rule annotated with ``@StartRule``, including its style prefix.
+
+        :Returns:
+            str
+        )mydelimiter";
+
+constexpr const char* RiGetHidden = R"mydelimiter(
+        get_hidden_attributes() -> set
+
+        Returns the names of the CGA rule attributes annotated with ``@Hidden``.
+
+        :Returns:
+            set
+        )mydelimiter";
+
+constexpr const char* RiGetAttrs = R"mydelimiter(
+        get_attributes_info() -> dict
+
+        Returns the CGA rule attributes in the same format as ``get_rpk_attributes_info``.
+
+        :Returns:
+            dict
+        )mydelimiter";
+
 constexpr const char* Is = R"mydelimiter(
         __init__(*args, **kwargs)
 
         The initial shape corresponds to the geometry on which the CGA rule will be applied.
         )mydelimiter";
 
-constexpr const char* IsInitV = R"mydelimiter(
+constexpr const char* IsInitVB = R"mydelimiter(
         1. **__init__** (*vert_coordinates*)
 
+        Constructs an InitialShape with one polygon from a buffer of vertex coordinates, like a NumPy array or a
+        memoryview. Buffers of any numeric type are converted natively, C-contiguous float64 buffers are copied as a
+        whole. The vertex order is expected to be counter-clockwise.
+
+        :Parameters:
+            **vert_coordinates** -- numeric buffer
+        :Example: ``shape1 = pyprt.InitialShape(numpy.array([0, 0, 0, 0, 0, 10, 10, 0, 10, 10, 0, 0], dtype=numpy.float32))``
+        )mydelimiter";
+
+constexpr const char* IsInitVIB = R"mydelimiter(
+        2. **__init__** (*vert_coordinates*, *face_indices*, *face_count*, *holes*)
+
+        Constructs an InitialShape from buffers of vertex coordinates, vertex indices and indices count per face,
+        like NumPy arrays or memoryviews. Buffers of any numeric type are converted natively, C-contiguous float64
+        coordinates and uint32 indices and counts are copied as a whole. Integer buffers must not hold negative values
+        or values above the uint32 range. The optional *holes* are given as for the list overload below.
+
+        :Parameters:
+            - **vert_coordinates** -- numeric buffer
+            - **face_indices** -- integer buffer
+            - **face_count** -- integer buffer
+            - **holes** -- List[List[int]]
+        :Example: ``shape2 = pyprt.InitialShape(numpy.array([0, 0, 0, 0, 0, 10, 10, 0, 10, 10, 0, 0]), numpy.arange(4), numpy.array([4]))``
+        )mydelimiter";
+
+constexpr const char* IsInitV = R"mydelimiter(
+        3. **__init__** (*vert_coordinates*)
+
         Constructs an InitialShape with one polygon by accepting a list of direct vertex coordinates. The
         vertex order is expected to be counter-clockwise.
 
@@ -77,7 +306,7 @@ constexpr const char* IsInitV = R"mydelimiter(
         )mydelimiter";
 
 constexpr const char* IsInitVI = R"mydelimiter(
-        2. **__init__** (*vert_coordinates*, *face_indices*, *face_count*, *holes*)
+        4. **__init__** (*vert_coordinates*, *face_indices*, *face_count*, *holes*)
 
         Constructs an InitialShape by accepting a list of direct vertex coordinates, a list of the vertex
         indices for each faces and a list of the indices count per face. The vertex order is expected to 
@@ -100,10 +329,12 @@ constexpr const char* IsInitVI = R"mydelimiter(
         )mydelimiter";
 
 constexpr const char* IsInitP = R"mydelimiter(
-        3. **__init__** (*init_shape_path*)
+        5. **__init__** (*init_shape_path*)
 
         Constructs an InitialShape by accepting the path to a shape file. This can be an OBJ file, Collada, etc.
         A list of supported file formats can be found at `PRT geometry encoders <https://esri.github.io/cityengine-sdk/html/esri_prt_codecs.html>`_.
+        OBJ files without texture coordinates and materials are decoded once and shared by all ModelGenerator instances,
+        see ``get_geometry_cache_stats``.
 
         :Parameters:
             **initial_shape_path** -- str
@@ -149,17 +380,103 @@ constexpr const char* IsGetP = R"mydelimiter(
             str
         )mydelimiter";
 
+constexpr const char* Isb = R"mydelimiter(
+        __init__(vert_coordinates, face_indices, face_count, vertex_offsets, index_offsets, face_count_offsets, holes=None, hole_offsets=None)
+
+        The InitialShapeBatch holds many initial shapes in a few contiguous buffers instead of one
+        :py:class:`InitialShape <pyprt.pyprt.bin.pyprt.InitialShape>` per shape. The buffers of all shapes are
+        concatenated and the offset arrays, with one entry more than there are shapes, delimit the part of each buffer
+        belonging to a shape: shape *i* uses the vertices *vertex_offsets[i]* to *vertex_offsets[i+1]* and so on.
+        The face indices are relative to the first vertex of their shape. The optional *holes* follow the flat PRT
+        layout: for each face with holes, the face index followed by the hole face indices and terminated by
+        4294967295. Any numeric buffers (e.g. NumPy arrays) or lists are accepted. Slicing a batch does not copy the
+        geometry, e.g. ``batch[1000:2000]``.
+
+        :Parameters:
+            - **vert_coordinates** -- List[float] or buffer, all vertex coordinates
+            - **face_indices** -- List[int] or buffer, all face vertex indices
+            - **face_count** -- List[int] or buffer, all face vertex counts
+            - **vertex_offsets** -- List[int] or buffer, per-shape offsets in vertices (not coordinates)
+            - **index_offsets** -- List[int] or buffer, per-shape offsets into *face_indices*
+            - **face_count_offsets** -- List[int] or buffer, per-shape offsets into *face_count*
+            - **holes** -- (optional) List[int] or buffer
+            - **hole_offsets** -- (optional) List[int] or buffer, per-shape offsets into *holes*
+        :Example: ``batch = pyprt.InitialShapeBatch(v, i, f, [0, 4, 8], [0, 4, 8], [0, 1, 2])``
+        )mydelimiter";
+
+constexpr const char* IsbFromRings = R"mydelimiter(
+        from_rings(coordinates, ring_offsets, shape_offsets, dimensions=2) -> InitialShapeBatch
+
+        Builds an :py:class:`InitialShapeBatch <pyprt.pyprt.bin.pyprt.InitialShapeBatch>` from polygon rings stored
+        in flat arrays, like GeoArrow polygons or ArcGIS geometries. The interleaved *coordinates* are in GIS
+        conventions (z is up) and are converted to the PRT conventions in one native pass: (x, y, z) becomes
+        (x, z, -y), a closing vertex equal to the first one is dropped and the rings are reordered where needed.
+        Within a shape, the rings with the same orientation as the first ring are faces and the others are holes of
+        the preceding face.
+
+        :Parameters:
+            - **coordinates** -- List[float] or buffer, interleaved x/y or x/y/z coordinates of all rings
+            - **ring_offsets** -- List[int] or buffer, offsets of the rings in vertices, one more than there are rings
+            - **shape_offsets** -- List[int] or buffer, offsets of the shapes in rings, one more than there are shapes
+            - **dimensions** -- int, 2 or 3
+        :Returns:
+            InitialShapeBatch
+        )mydelimiter";
+
+constexpr const char* IsbFromFile = R"mydelimiter(
+        from_file(path) -> InitialShapeBatch
+
+        Builds an :py:class:`InitialShapeBatch <pyprt.pyprt.bin.pyprt.InitialShapeBatch>` from an OBJ file with one
+        shape per object or group (``o`` and ``g`` statements), in a single decode of the file. Only the polygon
+        geometry is read, texture coordinates and materials are ignored. The decoded file is kept in the geometry cache,
+        see ``get_geometry_cache_stats``.
+
+        :Parameters:
+            **path** -- str
+        :Returns:
+            InitialShapeBatch
+        )mydelimiter";
+
+constexpr const char* IsbFromWKB = R"mydelimiter(
+        from_wkb(geometries, num_threads=0) -> InitialShapeBatch
+
+        Builds an :py:class:`InitialShapeBatch <pyprt.pyprt.bin.pyprt.InitialShapeBatch>` with one shape per WKB
+        geometry, e.g. from ``geopandas.GeoSeries.to_wkb()`` or ``shapely.to_wkb()``. Polygon and MultiPolygon
+        geometries in WKB or EWKB encoding, with or without Z, are supported. Every polygon becomes one face and its
+        interior rings become holes of that face. The coordinates are converted like in
+        :py:meth:`from_rings <pyprt.pyprt.bin.pyprt.InitialShapeBatch.from_rings>`. The geometries are parsed on
+        several threads without holding the GIL.
+
+        :Parameters:
+            - **geometries** -- iterable of bytes or other byte buffers
+            - **num_threads** -- int, number of parsing threads, *0* uses all hardware threads
+        :Returns:
+            InitialShapeBatch
+        )mydelimiter";
+
+constexpr const char* IsbGetV = R"mydelimiter(
+        get_vertex_count() -> int
+
+        Returns the number of vertices of all the shapes in the batch.
+
+        :Returns:
+            int
+        )mydelimiter";
+
 constexpr const char* Mg =
         "The ModelGenerator class will host the data required to procedurally generate the 3D model on "
         "a given initial shape.";
 
 constexpr const char* MgInit = R"mydelimiter(
-        __init__(init_shapes)
+        __init__(init_shapes, num_threads=0)
 
         The ModelGenerator constructor takes a list of :py:class:`InitialShape <pyprt.pyprt.bin.pyprt.InitialShape>` instances as parameter.
+        An :py:class:`InitialShapeBatch <pyprt.pyprt.bin.pyprt.InitialShapeBatch>` can be given instead. The initial
+        shape geometries are set up on several threads while the GIL is released.
 
         :Parameters:
-            **init_shapes** -- List[InitialShape]
+            - **init_shapes** -- List[InitialShape] or InitialShapeBatch
+            - **num_threads** -- int, number of threads setting up the geometry, *0* uses all hardware threads
 
         )mydelimiter";
 
@@ -175,16 +492,35 @@ constexpr const char* MgGen = R"mydelimiter(
         ``get_rpk_attributes_info`` function to know these input attributes). Concerning the encoder, you can use the
         ``'com.esri.pyprt.PyEncoder'`` or any other geometry encoder. The PyEncoder has these options:
         ``'emitGeometry'``, ``'emitReport'`` and ``'triangulate'`` whose value is a boolean. The complete list of the other geometry
-        encoders can be found `here <https://esri.github.io/cityengine-sdk/html/esri_prt_codecs.html>`__. In
+        encoders can be found `here <https://esri.github.io/cityengine-sdk/html/esri_prt_codecs.html>`__. With any
+        encoder, the boolean ``'emitAttributes'``, ``'emitPrints'`` and ``'emitErrors'`` entries of the encoder options
+        (all *True* by default) switch off the evaluation of the CGA attributes, the collection of the CGA prints and of
+        the CGA errors, which speeds up geometry-only runs. In
         case you are using another geometry encoder than the PyEncoder, you can add an ``'outputPath'`` entry to
         the shape attribute dictionary to specify where the generated 3D geometry will be outputted. In this case,
-        the return value of this *generate_model* function will be an empty list.
+        the return value of this *generate_model* function will be an empty list. With the PyEncoder, the initial shapes
+        can be generated on several threads by setting ``numThreads`` (*0* uses one thread per core). Idle threads pick
+        up the remaining initial shapes, the result list keeps the order of the initial shapes. With any encoder, the
+        initial shapes and their attributes are also prepared on ``numThreads`` threads.
+
+        Instead of a list of dictionaries, the shape attributes can be given as one dictionary of columns: each value
+        is a NumPy array or a list with one value per initial shape, or a scalar which applies to all initial shapes
+        (including ``'seed'`` and ``'shapeName'``). Each column is converted once into native storage, which is much
+        faster for many initial shapes. Array attributes are only supported with a list of dictionaries.
+
+        Several geometry encoders can be given as a list, together with a list of encoder options dictionaries (one per
+        encoder) or a single dictionary for all of them. The models are then generated once and encoded by each encoder,
+        for example ``['com.esri.pyprt.PyEncoder', 'com.esri.prt.codecs.OBJEncoder']`` returns the generated models
+        and writes the OBJ files into the ``'outputPath'`` of the OBJ encoder options. All file encoders of a call write
+        into the same ``'outputPath'``, different ones raise a ValueError. Combined with file encoders, the PyEncoder
+        generates all initial shapes on one thread.
 
         :Parameters:
-            - **shape_attributes** -- List[dict]
+            - **shape_attributes** -- List[dict] or dict of columns
             - **rule_package_path** -- str
-            - **geometry_encoder** -- str
-            - **encoder_options** -- dict
+            - **geometry_encoder** -- str or List[str]
+            - **encoder_options** -- dict or List[dict]
+            - **num_threads** -- int (optional, default: 1)
 
         :Returns:
             List[GeneratedModel]
@@ -200,6 +536,103 @@ constexpr const char* MgGen = R"mydelimiter(
             ``models1 = m.generate_model([attrs1, attrs2], rpk, 'com.esri.pyprt.PyEncoder', {'emitReport': True, 'emitGeometry': True})``
         )mydelimiter";
 
+constexpr const char* MgGenAsync = R"mydelimiter(
+        generate_model_async(*args, **kwargs) -> GenerateModelFuture
+
+        Asynchronous variant of ``generate_model`` with the same arguments. The generation runs on a native thread pool
+        and the function returns immediately with a :py:class:`concurrent.futures.Future` whose result is the list of
+        :py:class:`GeneratedModel <pyprt.pyprt.bin.pyprt.GeneratedModel>` instances. The future can also be awaited in
+        an asyncio coroutine. Calling ``cancel()`` on the future before the generation has started skips it.
+
+        :Parameters:
+            - **shape_attributes** -- List[dict]
+            - **rule_package_path** -- str
+            - **geometry_encoder** -- str or List[str]
+            - **encoder_options** -- dict or List[dict]
+            - **num_threads** -- int (optional, default: 1)
+
+        :Returns:
+            GenerateModelFuture
+        :Example:
+            ``future = m.generate_model_async([attrs], rpk, 'com.esri.pyprt.PyEncoder', {})``
+
+            ``models = future.result()`` or ``models = await future``
+        )mydelimiter";
+
+constexpr const char* MgGenIter = R"mydelimiter(
+        generate_model_iter(*args, **kwargs) -> GeneratedModelIterator
+
+        Streaming variant of ``generate_model`` for large numbers of initial shapes. It returns an iterator over
+        batches of at most ``batchSize`` :py:class:`GeneratedModel <pyprt.pyprt.bin.pyprt.GeneratedModel>` instances,
+        in initial shape order. The next batches are generated in the background while the current one is processed,
+        but never more than ``maxBatchesInFlight`` batches are generated ahead, which bounds the memory used.
+
+        :Parameters:
+            - **shape_attributes** -- List[dict]
+            - **rule_package_path** -- str
+            - **geometry_encoder** -- str or List[str]
+            - **encoder_options** -- dict or List[dict]
+            - **batch_size** -- int (optional, default: 256)
+            - **max_batches_in_flight** -- int (optional, default: 2)
+            - **num_threads** -- int (optional, default: 1)
+
+        :Returns:
+            GeneratedModelIterator
+        :Example:
+            ``for models in m.generate_model_iter([attrs], rpk, 'com.esri.pyprt.PyEncoder', {}, batchSize=1000):``
+
+            ``    process(models)``
+        )mydelimiter";
+
+constexpr const char* GmvArrowStream = R"mydelimiter(
+        __arrow_c_stream__(requested_schema=None) -> PyCapsule
+
+        Exports the geometry of the generated models through the Arrow PyCapsule interface, e.g.
+        ``pyarrow.table(models)`` or ``pyarrow.RecordBatchReader.from_stream(models)``. Every model is one row with the
+        columns *initial_shape_index* (uint64), *vertices* (list of 3D float64 points), *indices* (list of uint32) and
+        *face_counts* (list of uint32). The rows are grouped into record batches of up to 65536 models, fewer if the
+        geometry of a batch would exceed 2^31 - 1 points, indices or face counts. The geometry is copied into each batch
+        once when it is read from the stream. The *requested_schema* is ignored.
+
+        :Returns:
+            PyCapsule
+        )mydelimiter";
+
+constexpr const char* GmvGetAttrColumns = R"mydelimiter(
+        get_attribute_columns() -> dict
+
+        Returns the CGA attributes of all the generated models column by column: one NumPy masked array per attribute
+        name with one row per model, in the order of the models. Rows of models without a value for the attribute are
+        masked. Boolean and float attributes are stored in bool and float64 arrays, string and array attributes in
+        object arrays. The result can be passed directly to ``pandas.DataFrame``.
+
+        :Returns:
+            dict
+        :Example: ``df = pandas.DataFrame(models.get_attribute_columns())``
+        )mydelimiter";
+
+constexpr const char* GmvGetReportColumns = R"mydelimiter(
+        get_report_columns() -> dict
+
+        Returns the CGA reports of all the generated models column by column, with one row per model in the order of
+        the models. Float and bool reports are NumPy masked arrays of type float64 and bool, masked for models without
+        the report. String reports are dictionary encoded as a tuple of int32 codes (*-1* for models without the
+        report) and the list of distinct strings. The reports are only available if the ``'emitReport'`` option of
+        the PyEncoder is *True*.
+
+        :Returns:
+            dict
+        :Example: ``pandas.Categorical.from_codes(*models.get_report_columns()['zoning'])``
+        )mydelimiter";
+
+constexpr const char* Gmi =
+        "Iterator over batches of :py:class:`GeneratedModel <pyprt.pyprt.bin.pyprt.GeneratedModel>` instances returned "
+        "by ``ModelGenerator.generate_model_iter``.";
+
+constexpr const char* GenerateModelFuture =
+        "A :py:class:`concurrent.futures.Future` returned by ``ModelGenerator.generate_model_async``, which can also be "
+        "awaited in an asyncio coroutine.";
+
 constexpr const char* Gm =
         "The GeneratedModel instance contains the generated 3D geometry. This class is only employed "
         "if the *com.esri.pyprt.PyEncoder* encoder is used in the :py:class:`ModelGenerator "
@@ -248,6 +681,36 @@ constexpr const char* GmGetF = R"mydelimiter(
             List[int]
         )mydelimiter";
 
+constexpr const char* GmGetVArray = R"mydelimiter(
+        get_vertices_array() -> numpy.ndarray
+
+        Returns the generated 3D geometry vertex coordinates as a read-only NumPy array of shape (number of vertices, 3)
+        and type float64. The array is a view on the generated geometry, no data is copied. Requires NumPy.
+
+        :Returns:
+            numpy.ndarray
+        )mydelimiter";
+
+constexpr const char* GmGetIArray = R"mydelimiter(
+        get_indices_array() -> numpy.ndarray
+
+        Returns the vertex indices of all faces of the generated 3D geometry as a read-only one-dimensional NumPy array
+        of type uint32, without copying the data. Requires NumPy.
+
+        :Returns:
+            numpy.ndarray
+        )mydelimiter";
+
+constexpr const char* GmGetFArray = R"mydelimiter(
+        get_faces_array() -> numpy.ndarray
+
+        Returns the vertex indices count per face of the generated 3D geometry as a read-only one-dimensional NumPy
+        array of type uint32, without copying the data. Requires NumPy.
+
+        :Returns:
+            numpy.ndarray
+        )mydelimiter";
+
 constexpr const char* GmGetR = R"mydelimiter(
         get_report() -> dict
 
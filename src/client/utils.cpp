@@ -25,8 +25,14 @@
 #include "pybind11/pybind11.h"
 
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
 
 #ifdef _WIN32
 #	include <Windows.h>
@@ -279,9 +285,13 @@ std::wstring toUTF16FromUTF8(const std::string& utf8String) {
 	return callAPI<char, wchar_t>(prt::StringUtils::toUTF16FromUTF8, utf8String);
 }
 
+std::string toUTF8FromUTF16(const std::wstring& utf16String) {
+	return callAPI<wchar_t, char>(prt::StringUtils::toUTF8FromUTF16, utf16String);
+}
+
 std::string toUTF8FromOSNarrow(const std::string& osString) {
 	std::wstring utf16String = toUTF16FromOSNarrow(osString);
-	return callAPI<wchar_t, char>(prt::StringUtils::toUTF8FromUTF16, utf16String);
+	return toUTF8FromUTF16(utf16String);
 }
 
 std::string percentEncode(const std::string& utf8String) {
@@ -319,11 +329,31 @@ URI toFileURI(const std::string& p) {
 	return FILE_SCHEMA + u8PE;
 }
 
-AttributeMapPtr createValidatedOptions(const std::wstring& encID, const AttributeMapPtr& unvalidatedOptions) {
-	const EncoderInfoPtr encInfo{prt::createEncoderInfo(encID.c_str())};
-	const prt::AttributeMap* validatedOptions = nullptr;
-	encInfo->createValidatedOptionsAndStates(unvalidatedOptions.get(), &validatedOptions);
-	return AttributeMapPtr(validatedOptions);
+/**
+ * Hashes the file content (64bit FNV-1a) and returns it as hex string, suffixed with the file size.
+ * Returns an empty string if the file cannot be read.
+ */
+std::string getContentHash(const std::filesystem::path& path) {
+	std::ifstream in(path, std::ios::binary);
+	if (!in)
+		return {};
+
+	uint64_t hash = 14695981039346656037ull;
+	uint64_t size = 0;
+	std::vector<char> buffer(1 << 20);
+	while (in) {
+		in.read(buffer.data(), buffer.size());
+		const std::streamsize count = in.gcount();
+		for (std::streamsize i = 0; i < count; i++) {
+			hash ^= static_cast<unsigned char>(buffer[i]);
+			hash *= 1099511628211ull;
+		}
+		size += static_cast<uint64_t>(count);
+	}
+
+	std::ostringstream hex;
+	hex << std::hex << std::setw(16) << std::setfill('0') << hash << '-' << std::dec << size;
+	return hex.str();
 }
 
 std::string makeGeneric(const std::string& s) {
@@ -364,6 +394,52 @@ std::filesystem::path getLibraryPath(const void* func) {
 	return result;
 }
 
+/**
+ * Zero requests one thread per hardware core.
+ */
+size_t getThreadCount(size_t requestedThreads) {
+	if (requestedThreads > 0)
+		return requestedThreads;
+	return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+/**
+ * Calls func for each work unit index on up to threadCount threads (including the calling one). Idle threads pull the
+ * next unit from a shared counter, so units of very different cost keep all threads busy. The first exception thrown
+ * by func is rethrown after all threads have finished.
+ */
+void parallelFor(size_t unitCount, size_t threadCount, const std::function<void(size_t)>& func) {
+	std::atomic<size_t> nextUnit(0);
+	std::exception_ptr firstException;
+	std::mutex exceptionMutex;
+
+	auto worker = [&]() {
+		for (size_t unit = nextUnit++; unit < unitCount; unit = nextUnit++) {
+			try {
+				func(unit);
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock(exceptionMutex);
+				if (!firstException)
+					firstException = std::current_exception();
+				nextUnit = unitCount; // stop handing out work
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	const size_t extraThreads = std::min(threadCount, unitCount) > 1 ? std::min(threadCount, unitCount) - 1 : 0;
+	threads.reserve(extraThreads);
+	for (size_t t = 0; t < extraThreads; t++)
+		threads.emplace_back(worker);
+	worker();
+	for (std::thread& thread : threads)
+		thread.join();
+
+	if (firstException)
+		std::rethrow_exception(firstException);
+}
+
 std::filesystem::path getModuleDirectory() {
 	const auto p = getLibraryPath(reinterpret_cast<const void*>(getLibraryPath));
 	return p.parent_path();
@@ -27,10 +27,16 @@
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <filesystem>
+#include <functional>
 #include <ostream>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 namespace py = pybind11;
 
@@ -44,7 +50,6 @@ std::unordered_set<std::wstring> getHiddenAttributes(const RuleFileInfoUPtr& rul
 std::wstring removeDefaultStyleName(const wchar_t* key);
 
 AttributeMapPtr createAttributeMapFromPythonDict(const py::dict& args, prt::AttributeMapBuilder& bld);
-AttributeMapPtr createValidatedOptions(const std::wstring& encID, const AttributeMapPtr& unvalidatedOptions);
 
 template <typename C>
 std::vector<const C*> toPtrVec(const std::vector<std::basic_string<C>>& sv) {
@@ -60,9 +65,17 @@ std::vector<const C*> toPtrVec(const std::vector<std::unique_ptr<C, D>>& sv) {
 	return pv;
 }
 
+template <typename C>
+std::vector<const C*> toPtrVec(const std::vector<std::shared_ptr<C>>& sv) {
+	std::vector<const C*> pv(sv.size());
+	std::transform(sv.begin(), sv.end(), pv.begin(), [](const std::shared_ptr<C>& s) { return s.get(); });
+	return pv;
+}
+
 std::string toOSNarrowFromUTF16(const std::wstring& osWString);
 std::wstring toUTF16FromOSNarrow(const std::string& osString);
 std::wstring toUTF16FromUTF8(const std::string& utf8String);
+std::string toUTF8FromUTF16(const std::wstring& utf16String);
 std::string toUTF8FromOSNarrow(const std::string& osString);
 
 using URI = std::string;
@@ -71,6 +84,120 @@ std::string percentEncode(const std::string& utf8String);
 
 std::string objectToXML(const prt::Object* obj);
 
+std::string getContentHash(const std::filesystem::path& path);
+
+/**
+ * Converts a buffer value without silently changing it. Like the element wise conversion of pybind11, integer targets
+ * reject floating point values and values out of their range.
+ */
+template <typename T, typename S>
+T narrowBufferValue(S value) {
+	if constexpr (std::is_integral<T>::value && std::is_floating_point<S>::value) {
+		throw std::invalid_argument("expected integer values, got floating point values.");
+	}
+	else if constexpr (std::is_integral<T>::value) {
+		const T narrowed = static_cast<T>(value);
+		if (static_cast<S>(narrowed) != value || ((narrowed < T{}) != (value < S{})))
+			throw std::invalid_argument("value " + std::to_string(value) + " is out of range.");
+		return narrowed;
+	}
+	else {
+		return static_cast<T>(value);
+	}
+}
+
+template <typename T, typename S>
+void copyBufferValues(const py::buffer_info& info, std::vector<T>& values) {
+	const auto* data = static_cast<const char*>(info.ptr);
+	bool contiguous = true;
+	py::ssize_t expectedStride = info.itemsize;
+	for (py::ssize_t d = info.ndim - 1; d >= 0; d--) {
+		if (info.shape[d] > 1 && info.strides[d] != expectedStride)
+			contiguous = false;
+		expectedStride *= info.shape[d];
+	}
+	const auto innerStride = info.strides.empty() ? info.itemsize : info.strides.back();
+	values.resize(info.size);
+	if (contiguous && std::is_same<T, S>::value) {
+		std::memcpy(values.data(), data, info.size * sizeof(T));
+	}
+	else if (contiguous || info.ndim <= 1) {
+		const auto stride = contiguous ? info.itemsize : innerStride;
+		for (py::ssize_t i = 0; i < info.size; i++) {
+			S value;
+			std::memcpy(&value, data + i * stride, sizeof(S));
+			values[i] = narrowBufferValue<T, S>(value);
+		}
+	}
+	else {
+		throw std::invalid_argument("multi-dimensional buffers must be C-contiguous.");
+	}
+}
+
+/**
+ * Converts a sequence of numbers into a vector. Buffers (e.g. NumPy arrays) of any numeric type are converted
+ * natively, C-contiguous ones of the same type are copied as a whole. Other objects use the element wise conversion.
+ */
+template <typename T>
+std::vector<T> toVector(const py::object& values) {
+	if (!PyObject_CheckBuffer(values.ptr()))
+		return values.cast<std::vector<T>>();
+
+	const py::buffer_info info = py::reinterpret_borrow<py::buffer>(values).request();
+	std::string format = info.format;
+	if (!format.empty() && std::string("@=<").find(format[0]) != std::string::npos)
+		format.erase(0, 1);
+	if (format.size() != 1)
+		return values.cast<std::vector<T>>();
+
+	std::vector<T> result;
+	switch (format[0]) {
+		case '?':
+			copyBufferValues<T, bool>(info, result);
+			break;
+		case 'd':
+			copyBufferValues<T, double>(info, result);
+			break;
+		case 'f':
+			copyBufferValues<T, float>(info, result);
+			break;
+		case 'b':
+			copyBufferValues<T, int8_t>(info, result);
+			break;
+		case 'B':
+			copyBufferValues<T, uint8_t>(info, result);
+			break;
+		case 'h':
+			copyBufferValues<T, int16_t>(info, result);
+			break;
+		case 'H':
+			copyBufferValues<T, uint16_t>(info, result);
+			break;
+		case 'i':
+		case 'l':
+		case 'q':
+			if (info.itemsize == 4)
+				copyBufferValues<T, int32_t>(info, result);
+			else
+				copyBufferValues<T, int64_t>(info, result);
+			break;
+		case 'I':
+		case 'L':
+		case 'Q':
+			if (info.itemsize == 4)
+				copyBufferValues<T, uint32_t>(info, result);
+			else
+				copyBufferValues<T, uint64_t>(info, result);
+			break;
+		default:
+			return values.cast<std::vector<T>>();
+	}
+	return result;
+}
+
+size_t getThreadCount(size_t requestedThreads);
+void parallelFor(size_t unitCount, size_t threadCount, const std::function<void(size_t)>& func);
+
 /**
  * default initial shape geometry (a quad)
  */
@@ -20,9 +20,10 @@
 #pragma once
 
 #include "codec.h"
-#include "prt/Callbacks.h"
+#include "prt/SimpleOutputCallbacks.h"
 
-class PYENC_EXPORTS_API IPyCallbacks : public prt::Callbacks {
+// derives from the simple output callbacks so file encoders can run in the same generate call as the PyEncoder
+class PYENC_EXPORTS_API IPyCallbacks : public prt::SimpleOutputCallbacks {
 public:
 	virtual ~IPyCallbacks() override = default;
 
@@ -14,6 +14,7 @@
 # A copy of the license is available in the repository's LICENSE file.
 
 import os
+import tempfile
 import unittest
 
 import pyprt
@@ -43,3 +44,59 @@ class InspectRPKTest(unittest.TestCase):
                              'type': 'float'}
 
         self.assertDictEqual(inspect_dict['RearWindowWidth'], ground_truth_dict)
+
+    def test_rule_package_cache(self):
+        rpk = asset_file('candler.rpk')
+
+        pyprt.get_rpk_attributes_info(rpk)
+        stats_before = pyprt.get_rule_package_cache_stats()
+        pyprt.get_rpk_attributes_info(rpk)
+        stats_after = pyprt.get_rule_package_cache_stats()
+
+        self.assertEqual(stats_after['hits'], stats_before['hits'] + 1)
+        self.assertEqual(stats_after['misses'], stats_before['misses'])
+        self.assertGreaterEqual(stats_after['entries'], 1)
+
+    def test_rule_info(self):
+        rpk = asset_file('candler.rpk')
+
+        rule_info = pyprt.get_rule_info(rpk)
+        self.assertDictEqual(rule_info.get_attributes_info(), pyprt.get_rpk_attributes_info(rpk))
+        self.assertTrue(rule_info.get_rule_file().endswith('.cgb'))
+        self.assertNotEqual(rule_info.get_start_rule(), '')
+
+    def test_rpk_unpack_directory(self):
+        rpk = asset_file('candler.rpk')
+
+        with tempfile.TemporaryDirectory() as unpack_dir:
+            pyprt.set_rpk_unpack_directory(unpack_dir)
+            pyprt.clear_rule_package_cache()
+            try:
+                attrs = pyprt.get_rpk_attributes_info(rpk)
+                unpacked = [d for d in os.listdir(unpack_dir) if os.path.isdir(os.path.join(unpack_dir, d))]
+                self.assertEqual(len(unpacked), 1)
+                self.assertTrue(os.path.isfile(os.path.join(unpack_dir, unpacked[0], 'resolvemap.txt')))
+                rule_info_file = os.path.join(unpack_dir, unpacked[0] + '.ruleinfo')
+                self.assertTrue(os.path.isfile(rule_info_file))
+                stats = pyprt.get_rule_package_cache_stats()
+
+                # a fresh cache reuses the unpacked rule package and reads its rule info instead of creating it
+                pyprt.clear_rule_package_cache()
+                self.assertDictEqual(pyprt.get_rpk_attributes_info(rpk), attrs)
+                reread_stats = pyprt.get_rule_package_cache_stats()
+                self.assertEqual(reread_stats['rule_info_reads'], stats['rule_info_reads'] + 1)
+                self.assertEqual(reread_stats['rule_info_writes'], stats['rule_info_writes'])
+
+                # a corrupted rule info file is rejected and written again
+                with open(rule_info_file, 'wb') as f:
+                    f.write(b'not a rule info')
+                pyprt.clear_rule_package_cache()
+                self.assertDictEqual(pyprt.get_rpk_attributes_info(rpk), attrs)
+                rewritten_stats = pyprt.get_rule_package_cache_stats()
+                self.assertEqual(rewritten_stats['rule_info_reads'], reread_stats['rule_info_reads'])
+                self.assertEqual(rewritten_stats['rule_info_writes'], reread_stats['rule_info_writes'] + 1)
+                with open(rule_info_file, 'rb') as f:
+                    self.assertNotEqual(f.read(), b'not a rule info')
+            finally:
+                pyprt.set_rpk_unpack_directory('')
+                pyprt.clear_rule_package_cache()
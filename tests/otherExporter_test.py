@@ -54,3 +54,29 @@ class ExporterTest(unittest.TestCase):
             asset_output_file('Unittest4SLPK.slpk')))
         self.assertGreater(
             os.stat(asset_output_file('CGAReport.txt')).st_size, 0)
+
+    def test_multiple_geometry_encoders(self):
+        import tempfile
+
+        rpk = asset_file('extrusion_rule.rpk')
+        shapes = [pyprt.InitialShape([0, 0, 0, 0, 0, 10, 10, 0, 10, 10, 0, 0]),
+                  pyprt.InitialShape([20, 0, 0, 20, 0, 10, 30, 0, 10, 30, 0, 0])]
+        m = pyprt.ModelGenerator(shapes)
+        expected = m.generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', {})
+
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            models = m.generate_model([{}], rpk, ['com.esri.pyprt.PyEncoder', 'com.esri.prt.codecs.OBJEncoder'],
+                                      [{}, {'outputPath': tmp_dir}])
+            self.assertEqual(len(models), len(expected))
+            for model, expected_model in zip(models, expected):
+                self.assertEqual(model.get_vertices(), expected_model.get_vertices())
+            self.assertTrue(any(name.endswith('.obj') for name in os.listdir(tmp_dir)))
+
+            # the file encoders share one output directory
+            with tempfile.TemporaryDirectory() as other_dir:
+                with self.assertRaises(ValueError):
+                    m.generate_model([{}], rpk, ['com.esri.prt.codecs.OBJEncoder', 'com.esri.prt.codecs.I3SEncoder'],
+                                     [{'outputPath': tmp_dir}, {'outputPath': other_dir}])
+
+        with self.assertRaises(ValueError):
+            m.generate_model([{}], rpk, ['com.esri.pyprt.PyEncoder', 'com.esri.prt.codecs.OBJEncoder'], [{}])
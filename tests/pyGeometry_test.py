@@ -13,8 +13,10 @@
 # limitations under the License.
 # A copy of the license is available in the repository's LICENSE file.
 
+import asyncio
 import os
 import unittest
+from concurrent.futures import ThreadPoolExecutor
 
 import pyprt
 
@@ -74,6 +76,26 @@ class GeometryTest(unittest.TestCase):
         rep_round = {x: round(z, 2) for x, z in rep.items()}
         self.assertEqual(rep_round, ground_truth_dict)
 
+    def test_report_columns(self):
+        rpk = asset_file('envelope2002.rpk')
+        shape_geo_from_obj = pyprt.InitialShape(asset_file('building_parcel.obj'))
+        m = pyprt.ModelGenerator([shape_geo_from_obj, shape_geo_from_obj])
+        models = m.generate_model([{'report_but_not_display_green': True, 'seed': 666},
+                                   {'report_but_not_display_green': False, 'seed': 666}],
+                                  rpk, 'com.esri.pyprt.PyEncoder', {'emitReport': True, 'emitGeometry': False})
+
+        columns = models.get_report_columns()
+        for row, model in enumerate(models):
+            report = model.get_report()
+            for key, column in columns.items():
+                self.assertEqual(column.dtype.name, 'float64')
+                if key in report:
+                    self.assertFalse(column.mask[row])
+                    self.assertEqual(column[row], report[key])
+                else:
+                    self.assertTrue(column.mask[row])
+            self.assertTrue(set(report.keys()).issubset(columns.keys()))
+
     def test_noreport(self):
         rpk = asset_file('extrusion_rule.rpk')
         attrs = {}
@@ -192,6 +214,50 @@ class GeometryTest(unittest.TestCase):
 
         self.assertEqual(len(model[0].get_cga_errors()), 1)
 
+    def test_auxiliary_encoder_switches(self):
+        rpk = asset_file('envelope2002.rpk')
+        attrs = {'report_but_not_display_green': True, 'seed': 2}
+        shape_geo_from_obj = pyprt.InitialShape(asset_file('building_parcel.obj'))
+        m = pyprt.ModelGenerator([shape_geo_from_obj])
+
+        model = m.generate_model([attrs], rpk, 'com.esri.pyprt.PyEncoder', {
+            'emitReport': False, 'emitGeometry': True, 'emitPrints': False, 'emitAttributes': False})
+        self.assertEqual(model[0].get_cga_prints(), '')
+        self.assertDictEqual(model[0].get_attributes(), {})
+        self.assertGreater(len(model[0].get_vertices()), 0)
+
+        model = m.generate_model([attrs], rpk, 'com.esri.pyprt.PyEncoder', {
+            'emitReport': False, 'emitGeometry': False, 'emitPrints': True, 'emitAttributes': True})
+        self.assertEqual(model[0].get_cga_prints(), str(attrs['seed'])+"\n")
+        self.assertGreater(len(model[0].get_attributes()), 0)
+
+        model = m.generate_model([attrs], rpk, 'com.esri.pyprt.PyEncoder', {
+            'emitReport': False, 'emitGeometry': False, 'emitPrints': False, 'emitAttributes': False,
+            'emitErrors': False})
+        self.assertEqual(len(model), 1)
+        self.assertEqual(model[0].get_vertices(), [])
+        self.assertEqual(model[0].get_faces(), [])
+        self.assertEqual(len(model[0].get_vertices_array()), 0)
+        self.assertDictEqual(model[0].get_report(), {})
+        self.assertDictEqual(model[0].get_attributes(), {})
+        self.assertEqual(model[0].get_cga_prints(), '')
+        self.assertEqual(model[0].get_cga_errors(), [])
+
+    def test_encoder_options_cache(self):
+        rpk = asset_file('extrusion_rule.rpk')
+        m = pyprt.ModelGenerator([pyprt.InitialShape([0, 0, 0, 0, 0, 10, 10, 0, 10, 10, 0, 0])])
+        encoder_options = {'emitReport': True, 'emitGeometry': True}
+
+        expected = m.generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', encoder_options)
+        stats_before = pyprt.get_encoder_options_cache_stats()
+        models = m.generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', dict(encoder_options))
+        stats_after = pyprt.get_encoder_options_cache_stats()
+
+        self.assertEqual(stats_after['misses'], stats_before['misses'])
+        self.assertGreater(stats_after['hits'], stats_before['hits'])
+        self.assertEqual(models[0].get_vertices(), expected[0].get_vertices())
+        self.assertDictEqual(models[0].get_report(), expected[0].get_report())
+
     def test_attributesvalue_fct(self):
         rpk = asset_file('extrusion_rule.rpk')
         attrs = {'maxBuildingHeight':35.0}
@@ -205,6 +271,48 @@ class GeometryTest(unittest.TestCase):
         self.assertDictEqual(model[1].get_attributes(),
                 {'OBJECTID': 0.0, 'minBuildingHeight': 10.0, 'buildingColor': '#FF00FF', 'text': 'salut', 'maxBuildingHeight': 30.0})
 
+    def test_attribute_map_cache(self):
+        rpk = asset_file('extrusion_rule.rpk')
+        shape_geo_from_obj = pyprt.InitialShape(asset_file('building_parcel.obj'))
+        m = pyprt.ModelGenerator([shape_geo_from_obj, shape_geo_from_obj, shape_geo_from_obj])
+        encoder_options = {'emitReport': False, 'emitGeometry': False}
+        attrs = [{'maxBuildingHeight': 27.5, 'buildingColor': '#00FF00'},
+                 {'maxBuildingHeight': 27.5, 'buildingColor': '#00FF00'},
+                 {'maxBuildingHeight': 12.5}]
+
+        expected = m.generate_model(attrs, rpk, 'com.esri.pyprt.PyEncoder', encoder_options)
+        stats_before = pyprt.get_attribute_map_cache_stats()
+        models = m.generate_model(attrs, rpk, 'com.esri.pyprt.PyEncoder', encoder_options)
+        stats_after = pyprt.get_attribute_map_cache_stats()
+
+        self.assertEqual(stats_after['hits'], stats_before['hits'] + 3)
+        self.assertEqual(stats_after['misses'], stats_before['misses'])
+        for model, expected_model in zip(models, expected):
+            self.assertDictEqual(model.get_attributes(), expected_model.get_attributes())
+
+    def test_attribute_columns(self):
+        rpk = asset_file('extrusion_rule.rpk')
+        shape_geo_from_obj = pyprt.InitialShape(asset_file('building_parcel.obj'))
+        m = pyprt.ModelGenerator([shape_geo_from_obj, shape_geo_from_obj])
+        models = m.generate_model([{'maxBuildingHeight': 35.0}, {}], rpk, 'com.esri.pyprt.PyEncoder', {})
+
+        columns = models.get_attribute_columns()
+        self.assertEqual(sorted(columns.keys()), sorted(models[0].get_attributes().keys()))
+        self.assertEqual(columns['maxBuildingHeight'].dtype.name, 'float64')
+        self.assertEqual(columns['maxBuildingHeight'].tolist(), [35.0, 30.0])
+        self.assertEqual(columns['text'].tolist(), ['salut', 'salut'])
+        self.assertFalse(columns['maxBuildingHeight'].mask.any())
+
+    def test_attribute_columns_arrays(self):
+        rpk = asset_file('arrayAttrs.rpk')
+        m = pyprt.ModelGenerator([pyprt.InitialShape(asset_file('building_parcel.obj'))])
+        models = m.generate_model([{'arrayAttrFloat': [0.0, 1.0, 2.0]}], rpk, 'com.esri.pyprt.PyEncoder', {})
+
+        columns = models.get_attribute_columns()
+        self.assertEqual(columns['arrayAttrFloat'].dtype.name, 'object')
+        self.assertEqual(columns['arrayAttrFloat'][0], [0.0, 1.0, 2.0])
+        self.assertEqual(columns['arrayAttrBool'][0], [False])
+
     def test_attributesvalue_fct_arrays(self):
         rpk = asset_file('arrayAttrs.rpk')
         attrs = {'arrayAttrFloat': [0.0, 1.0, 2.0]}
@@ -228,3 +336,373 @@ class GeometryTest(unittest.TestCase):
                                                   ['second', 'row'],
                                                   ['third', 'row'],
                                                   ['fourth', 'row']]})
+
+    def test_shared_cache(self):
+        rpk = asset_file('extrusion_rule.rpk')
+        geometry_file = asset_file('candler_footprint.obj')
+        m = pyprt.ModelGenerator([pyprt.InitialShape(geometry_file)])
+        model = m.generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', {
+                                 'emitReport': False, 'emitGeometry': True})
+        stats = pyprt.get_cache_stats()
+        self.assertGreaterEqual(stats['entries'], 1)
+        self.assertGreater(stats['bytes'], 0)
+
+        pyprt.flush_cache_entry(geometry_file)
+        self.assertLess(pyprt.get_cache_stats()['bytes'], stats['bytes'])
+
+        pyprt.flush_cache()
+        self.assertEqual(pyprt.get_cache_stats()['entries'], 0)
+
+        # flushed resources are loaded again on their next use
+        model_after_flush = m.generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', {
+                                             'emitReport': False, 'emitGeometry': True})
+        self.assertEqual(len(model_after_flush[0].get_vertices()), len(model[0].get_vertices()))
+
+    def test_shared_cache_rewritten_rpk(self):
+        import shutil
+        import tempfile
+
+        m = pyprt.ModelGenerator([pyprt.InitialShape(asset_file('building_parcel.obj'))])
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            rpk = os.path.join(tmp_dir, 'rule.rpk')
+            shutil.copyfile(asset_file('extrusion_rule.rpk'), rpk)
+            attributes = m.generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', {})[0].get_attributes()
+
+            # a rule package rewritten at the same path must not be served from the shared cache
+            shutil.copyfile(asset_file('arrayAttrs.rpk'), rpk)
+            rewritten_attributes = m.generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', {})[0].get_attributes()
+            self.assertNotEqual(set(rewritten_attributes.keys()), set(attributes.keys()))
+            self.assertIn('arrayAttrFloat', rewritten_attributes)
+
+    def test_shared_cache_flush_count(self):
+        rpk = asset_file('extrusion_rule.rpk')
+        m = pyprt.ModelGenerator([pyprt.InitialShape([0, 0, 0, 0, 0, 10, 10, 0, 10, 10, 0, 0])])
+        m.generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', {})
+        flushes = pyprt.get_cache_stats()['flushes']
+
+        # only tracked resources count as flushes
+        pyprt.flush_cache_entry('file:/not/a/cached/resource.rpk')
+        self.assertEqual(pyprt.get_cache_stats()['flushes'], flushes)
+        pyprt.flush_cache_entry(rpk)
+        self.assertEqual(pyprt.get_cache_stats()['flushes'], flushes + 1)
+
+    def test_generate_in_threads(self):
+        rpk = asset_file('candler.rpk')
+
+        def generate(_):
+            m = pyprt.ModelGenerator([pyprt.InitialShape(asset_file('candler_footprint.obj'))])
+            model = m.generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', {
+                                     'emitReport': True, 'emitGeometry': True})
+            return len(model[0].get_vertices()), model[0].get_report()
+
+        expected = generate(0)
+        with ThreadPoolExecutor(max_workers=4) as executor:
+            for result in executor.map(generate, range(4)):
+                self.assertEqual(result[0], expected[0])
+                self.assertDictEqual(result[1], expected[1])
+
+    def test_generate_multithreaded(self):
+        rpk = asset_file('extrusion_rule.rpk')
+        shapes = [pyprt.InitialShape([0, 0, 0, 0, 0, 100, 100, 0, 100, 100, 0, 0]),
+                  pyprt.InitialShape(asset_file('candler_footprint.obj')),
+                  pyprt.InitialShape([0, 0, 0, 0, 0, 10, 10, 0, 10, 10, 0, 0])] * 5
+        m = pyprt.ModelGenerator(shapes)
+        encoder_options = {'emitReport': True, 'emitGeometry': True}
+
+        models = m.generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', encoder_options)
+        models_mt = m.generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', encoder_options, numThreads=4)
+
+        self.assertEqual(len(models_mt), len(shapes))
+        for model, model_mt in zip(models, models_mt):
+            self.assertEqual(model_mt.get_initial_shape_index(), model.get_initial_shape_index())
+            self.assertEqual(model_mt.get_vertices(), model.get_vertices())
+            self.assertDictEqual(model_mt.get_report(), model.get_report())
+
+    def test_concurrent_calls_on_one_generator(self):
+        rpk = asset_file('extrusion_rule.rpk')
+        m = pyprt.ModelGenerator([pyprt.InitialShape([0, 0, 0, 0, 0, 100, 100, 0, 100, 100, 0, 0])])
+        heights = [10.0 + i for i in range(8)]
+
+        def generate(height):
+            attrs = {'minBuildingHeight': height, 'maxBuildingHeight': height}
+            model = m.generate_model([attrs], rpk, 'com.esri.pyprt.PyEncoder', {
+                                     'emitReport': False, 'emitGeometry': False})
+            return model[0].get_attributes()['maxBuildingHeight']
+
+        with ThreadPoolExecutor(max_workers=4) as executor:
+            self.assertEqual(list(executor.map(generate, heights)), heights)
+
+    def test_generate_model_async(self):
+        rpk = asset_file('candler.rpk')
+        m = pyprt.ModelGenerator([pyprt.InitialShape(asset_file('candler_footprint.obj'))])
+        encoder_options = {'emitReport': False, 'emitGeometry': True}
+
+        future = m.generate_model_async([{}], rpk, 'com.esri.pyprt.PyEncoder', encoder_options)
+        self.assertEqual(len(future.result()[0].get_vertices()), 97044*3)
+
+        async def generate():
+            return await m.generate_model_async([{}], rpk, 'com.esri.pyprt.PyEncoder', encoder_options)
+
+        loop = asyncio.new_event_loop()
+        try:
+            models = loop.run_until_complete(generate())
+        finally:
+            loop.close()
+        self.assertEqual(len(models[0].get_vertices()), 97044*3)
+
+    def test_generate_model_iter(self):
+        rpk = asset_file('extrusion_rule.rpk')
+        shapes = [pyprt.InitialShape([0, 0, 0, 0, 0, 10 + i, 10 + i, 0, 10 + i, 10 + i, 0, 0]) for i in range(10)]
+        m = pyprt.ModelGenerator(shapes)
+        encoder_options = {'emitReport': False, 'emitGeometry': True}
+
+        models = m.generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', encoder_options)
+        batches = list(m.generate_model_iter([{}], rpk, 'com.esri.pyprt.PyEncoder', encoder_options,
+                                             batchSize=3, maxBatchesInFlight=1))
+
+        self.assertEqual([len(batch) for batch in batches], [3, 3, 3, 1])
+        streamed = [model for batch in batches for model in batch]
+        for model, model_streamed in zip(models, streamed):
+            self.assertEqual(model_streamed.get_initial_shape_index(), model.get_initial_shape_index())
+            self.assertEqual(model_streamed.get_vertices(), model.get_vertices())
+
+        # a failing batch stops the iteration instead of yielding empty batches
+        with self.assertRaises(RuntimeError):
+            list(m.generate_model_iter([{}], asset_file('missing.rpk'), 'com.esri.pyprt.PyEncoder', encoder_options,
+                                       batchSize=3))
+
+    def test_geometry_arrays(self):
+        rpk = asset_file('candler.rpk')
+        m = pyprt.ModelGenerator([pyprt.InitialShape(asset_file('candler_footprint.obj'))])
+        model = m.generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', {
+                                 'emitReport': False, 'emitGeometry': True})[0]
+
+        vertices = model.get_vertices_array()
+        self.assertEqual(vertices.shape, (97044, 3))
+        self.assertEqual(vertices.dtype.name, 'float64')
+        self.assertFalse(vertices.flags.writeable)
+        self.assertEqual(vertices.ravel().tolist(), model.get_vertices())
+        self.assertEqual(model.get_indices_array().tolist(), model.get_indices())
+        self.assertEqual(model.get_faces_array().tolist(), model.get_faces())
+
+        # the arrays keep the generated geometry alive
+        faces = model.get_faces_array()
+        del model
+        self.assertEqual(len(faces), 47202)
+
+        # models without geometry return empty arrays, which are read-only as well
+        model = m.generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', {
+                                 'emitReport': False, 'emitGeometry': False})[0]
+        vertices = model.get_vertices_array()
+        self.assertEqual(vertices.shape, (0, 3))
+        self.assertFalse(vertices.flags.writeable)
+        self.assertFalse(model.get_indices_array().flags.writeable)
+        self.assertFalse(model.get_faces_array().flags.writeable)
+
+    def test_arrow_stream(self):
+        try:
+            import pyarrow as pa
+        except ImportError:
+            self.skipTest('pyarrow is not installed')
+
+        rpk = asset_file('extrusion_rule.rpk')
+        shapes = [pyprt.InitialShape([0, 0, 0, 0, 0, 10, 10, 0, 10, 10, 0, 0]),
+                  pyprt.InitialShape([0, 0, 0, 0, 0, 5, 5, 0, 0])]
+        models = pyprt.ModelGenerator(shapes).generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', {
+                                                             'emitReport': False})
+
+        table = pa.RecordBatchReader.from_stream(models).read_all()
+        del models
+        self.assertEqual(table.column_names, ['initial_shape_index', 'vertices', 'indices', 'face_counts'])
+        self.assertEqual(table.num_rows, 2)
+        self.assertEqual(len(table.to_batches()), 1)
+        self.assertEqual(table.column('initial_shape_index').to_pylist(), [0, 1])
+
+        expected = pyprt.ModelGenerator(shapes).generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', {
+                                                               'emitReport': False})
+        for row, model in zip(table.to_pylist(), expected):
+            self.assertEqual([c for point in row['vertices'] for c in point], model.get_vertices())
+            self.assertEqual(row['indices'], model.get_indices())
+            self.assertEqual(row['face_counts'], model.get_faces())
+
+    def test_initial_shape_from_buffers(self):
+        import numpy as np
+
+        rpk = asset_file('extrusion_rule.rpk')
+        vertices = [0, 0, 0, 0, 0, 10, 10, 0, 10, 10, 0, 0]
+        shapes = [pyprt.InitialShape(vertices),
+                  pyprt.InitialShape(np.array(vertices, dtype=np.float64)),
+                  pyprt.InitialShape(memoryview(np.array(vertices, dtype=np.float64))),
+                  pyprt.InitialShape(np.array(vertices, dtype=np.float64), np.arange(4, dtype=np.uint32),
+                                     np.array([4], dtype=np.uint32)),
+                  pyprt.InitialShape(np.array(vertices, dtype=np.int64)),
+                  pyprt.InitialShape(np.array(vertices, dtype=np.float32), np.arange(4, dtype=np.int64),
+                                     np.array([4], dtype=np.int64))]
+        for shape in shapes:
+            self.assertEqual(shape.get_vertex_count(), 12)
+            self.assertEqual(shape.get_index_count(), 4)
+
+        m = pyprt.ModelGenerator(shapes)
+        models = m.generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', {
+                                  'emitReport': False, 'emitGeometry': True})
+        for model in models[1:]:
+            self.assertEqual(model.get_vertices(), models[0].get_vertices())
+
+        with self.assertRaises(ValueError):
+            pyprt.InitialShape(np.array(vertices, dtype=np.float64), np.array([0, 1, 2, -3]), np.array([4]))
+
+    def test_parallel_initial_shapes(self):
+        import numpy as np
+
+        rpk = asset_file('extrusion_rule.rpk')
+        shapes = [pyprt.InitialShape([0, 0, 0, 0, 0, 10 + i, 10 + i, 0, 10 + i, 10 + i, 0, 0]) for i in range(50)]
+        heights = np.arange(10.0, 60.0)
+        columns = {'minBuildingHeight': heights, 'maxBuildingHeight': heights, 'seed': np.arange(50)}
+        dicts = [{'minBuildingHeight': h, 'maxBuildingHeight': h, 'seed': i} for i, h in enumerate(heights.tolist())]
+
+        expected = pyprt.ModelGenerator(shapes, 1).generate_model(dicts, rpk, 'com.esri.pyprt.PyEncoder', {})
+        m = pyprt.ModelGenerator(shapes, 4)
+        for attrs in (columns, dicts):
+            models = m.generate_model(attrs, rpk, 'com.esri.pyprt.PyEncoder', {}, 4)
+            self.assertEqual(len(models), 50)
+            for model, expected_model in zip(models, expected):
+                self.assertEqual(model.get_initial_shape_index(), expected_model.get_initial_shape_index())
+                self.assertEqual(model.get_vertices(), expected_model.get_vertices())
+
+    def test_geometry_cache(self):
+        import tempfile
+
+        rpk = asset_file('extrusion_rule.rpk')
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            obj_path = os.path.join(tmp_dir, 'footprints.obj')
+            with open(obj_path, 'w') as obj_file:
+                obj_file.write('v 0 0 0\nv 0 0 10\nv 10 0 10\nv 10 0 0\nv 20 0 0\nv 20 0 5\nv 25 0 0\n'
+                               'o first\nf 1 2 3 4\no second\nf 5 6 7\n')
+
+            shape = pyprt.InitialShape(obj_path)
+            pyprt.ModelGenerator([shape])
+            stats_before = pyprt.get_geometry_cache_stats()
+            models = pyprt.ModelGenerator([shape]).generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', {})
+            stats_after = pyprt.get_geometry_cache_stats()
+            self.assertEqual(stats_after['hits'], stats_before['hits'] + 1)
+            self.assertEqual(stats_after['misses'], stats_before['misses'])
+            self.assertEqual(len(models), 1)
+
+            batch = pyprt.InitialShapeBatch.from_file(obj_path)
+            self.assertEqual(len(batch), 2)
+            self.assertEqual(batch[0:1].get_vertex_count(), 4)
+            self.assertEqual(batch[1:2].get_vertex_count(), 3)
+
+            with self.assertRaises(ValueError):
+                pyprt.InitialShapeBatch.from_file(os.path.join(tmp_dir, 'missing.obj'))
+
+    def test_initial_shape_batch(self):
+        import numpy as np
+
+        rpk = asset_file('extrusion_rule.rpk')
+        square = [0, 0, 0, 0, 0, 10, 10, 0, 10, 10, 0, 0]
+        triangle = [0, 0, 0, 0, 0, 5, 5, 0, 0]
+        batch = pyprt.InitialShapeBatch(np.array(square + triangle + square, dtype=np.float64),
+                                        np.array([0, 1, 2, 3, 0, 1, 2, 0, 1, 2, 3], dtype=np.uint32),
+                                        np.array([4, 3, 4], dtype=np.uint32),
+                                        np.array([0, 4, 7, 11]), np.array([0, 4, 7, 11]), [0, 1, 2, 3])
+        self.assertEqual(len(batch), 3)
+        self.assertEqual(batch.get_vertex_count(), 11)
+
+        tail = batch[1:]
+        self.assertEqual(len(tail), 2)
+        self.assertEqual(tail.get_vertex_count(), 7)
+
+        shapes = [pyprt.InitialShape(triangle), pyprt.InitialShape(square)]
+        attrs = {'minBuildingHeight': 10.0, 'maxBuildingHeight': 10.0}
+        models = pyprt.ModelGenerator(tail).generate_model([attrs], rpk, 'com.esri.pyprt.PyEncoder', {})
+        expected = pyprt.ModelGenerator(shapes).generate_model([attrs], rpk, 'com.esri.pyprt.PyEncoder', {})
+        self.assertEqual(len(models), 2)
+        for model, expected_model in zip(models, expected):
+            self.assertEqual(model.get_vertices(), expected_model.get_vertices())
+            self.assertEqual(model.get_faces(), expected_model.get_faces())
+
+        with self.assertRaises(ValueError):
+            pyprt.InitialShapeBatch(square, [0, 1, 2, 3], [4], [0, 5], [0, 4], [0, 1])
+
+    def test_initial_shape_batch_invalid_buffers(self):
+        import numpy as np
+
+        square = np.array([0, 0, 0, 0, 0, 10, 10, 0, 10, 10, 0, 0], dtype=np.float64)
+        offsets = np.array([0, 4])
+
+        def create(indices, face_counts, index_offsets=offsets):
+            return pyprt.InitialShapeBatch(square, indices, face_counts, np.array([0, 4]), index_offsets, [0, 1])
+
+        self.assertEqual(len(create(np.array([0, 1, 2, 3], dtype=np.int64), np.array([4], dtype=np.int64))), 1)
+        # negative or too large values must not wrap around
+        with self.assertRaises(ValueError):
+            create(np.array([0, 1, 2, -1], dtype=np.int64), [4])
+        with self.assertRaises(ValueError):
+            create([0, 1, 2, 3], np.array([2 ** 32 + 4], dtype=np.int64))
+        # floating point offsets must not be truncated
+        with self.assertRaises(ValueError):
+            create([0, 1, 2, 3], [4], np.array([0.0, 4.5]))
+        # the face counts must add up to the number of indices, which must refer to the vertices of the shape
+        with self.assertRaises(ValueError):
+            create([0, 1, 2, 3], [3])
+        with self.assertRaises(ValueError):
+            create([0, 1, 2, 4], [4])
+
+    def test_initial_shape_batch_from_wkb(self):
+        import struct
+
+        def wkb_polygon(rings, byte_order='<', type_code=3, z=None):
+            fmt = byte_order + ('ddd' if z is not None else 'dd')
+            data = struct.pack(byte_order + 'BII', 1 if byte_order == '<' else 0, type_code, len(rings))
+            for ring in rings:
+                data += struct.pack(byte_order + 'I', len(ring))
+                for x, y in ring:
+                    data += struct.pack(fmt, *((x, y, z) if z is not None else (x, y)))
+            return data
+
+        rpk = asset_file('extrusion_rule.rpk')
+        exterior = [(0, 0), (10, 0), (10, 10), (0, 10), (0, 0)]
+        hole = [(2, 2), (2, 8), (8, 8), (8, 2), (2, 2)]
+        polygon = wkb_polygon([exterior, hole])
+        ewkb_z_polygon = wkb_polygon([exterior], '>', 0x80000003, 5.0)
+        multi_polygon = struct.pack('>BII', 0, 6, 1) + wkb_polygon([list(reversed(exterior))], '>')
+
+        batch = pyprt.InitialShapeBatch.from_wkb([polygon, ewkb_z_polygon, multi_polygon])
+        self.assertEqual(len(batch), 3)
+        self.assertEqual(batch.get_vertex_count(), 16)
+
+        exterior_vertices = [0, 0, 0, 10, 0, 0, 10, 0, -10, 0, 0, -10]
+        shapes = [pyprt.InitialShape(exterior_vertices + [2, 0, -2, 2, 0, -8, 8, 0, -8, 8, 0, -2],
+                                     list(range(8)), [4, 4], [[0, 1]]),
+                  pyprt.InitialShape([5 if i % 3 == 1 else c for i, c in enumerate(exterior_vertices)]),
+                  pyprt.InitialShape(exterior_vertices)]
+        models = pyprt.ModelGenerator(batch).generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', {})
+        expected = pyprt.ModelGenerator(shapes).generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', {})
+        for model, expected_model in zip(models, expected):
+            self.assertEqual(sorted(model.get_vertices()), sorted(expected_model.get_vertices()))
+
+        with self.assertRaises(ValueError):
+            pyprt.InitialShapeBatch.from_wkb([polygon[:-8]])
+
+    def test_initial_shape_batch_from_rings(self):
+        import numpy as np
+
+        rpk = asset_file('extrusion_rule.rpk')
+        # GIS conventions: clockwise exterior ring, counter-clockwise hole, closed rings
+        exterior = [0, 0, 0, 10, 10, 10, 10, 0, 0, 0]
+        hole = [2, 2, 8, 2, 8, 8, 2, 8, 2, 2]
+        batch = pyprt.InitialShapeBatch.from_rings(np.array(exterior + hole + exterior, dtype=np.float64),
+                                                   [0, 5, 10, 15], [0, 2, 3])
+        self.assertEqual(len(batch), 2)
+        self.assertEqual(batch.get_vertex_count(), 12)
+
+        expected_vertices = [10, 0, 0, 10, 0, -10, 0, 0, -10, 0, 0, 0,
+                             2, 0, -8, 8, 0, -8, 8, 0, -2, 2, 0, -2]
+        shapes = [pyprt.InitialShape(expected_vertices, list(range(8)), [4, 4], [[0, 1]]),
+                  pyprt.InitialShape(expected_vertices[:12])]
+        models = pyprt.ModelGenerator(batch).generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', {})
+        expected = pyprt.ModelGenerator(shapes).generate_model([{}], rpk, 'com.esri.pyprt.PyEncoder', {})
+        for model, expected_model in zip(models, expected):
+            self.assertEqual(model.get_vertices(), expected_model.get_vertices())
+            self.assertEqual(model.get_faces(), expected_model.get_faces())
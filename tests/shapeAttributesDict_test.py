@@ -112,3 +112,32 @@ class ShapeAttributesTest(unittest.TestCase):
             with open(expected_file, 'r') as cga_print_file:
                 cga_print = cga_print_file.read()
                 self.assertEqual(cga_print, expected_content)
+
+    def test_columnar_shape_attributes(self):
+        import numpy as np
+
+        rpk = asset_file('extrusion_rule.rpk')
+        shape_geo_from_obj = pyprt.InitialShape(asset_file('building_parcel.obj'))
+        m = pyprt.ModelGenerator([shape_geo_from_obj, shape_geo_from_obj, shape_geo_from_obj])
+        encoder_options = {'emitReport': False, 'emitGeometry': False}
+
+        heights = np.array([35.0, 20.0, 25.0])
+        columns = {'maxBuildingHeight': heights, 'minBuildingHeight': [15.0, 10.0, 12.0],
+                   'buildingColor': '#FF0000', 'seed': np.array([1, 2, 3])}
+        models = m.generate_model(columns, rpk, 'com.esri.pyprt.PyEncoder', encoder_options)
+
+        dicts = [{'maxBuildingHeight': 35.0, 'minBuildingHeight': 15.0, 'buildingColor': '#FF0000', 'seed': 1},
+                 {'maxBuildingHeight': 20.0, 'minBuildingHeight': 10.0, 'buildingColor': '#FF0000', 'seed': 2},
+                 {'maxBuildingHeight': 25.0, 'minBuildingHeight': 12.0, 'buildingColor': '#FF0000', 'seed': 3}]
+        expected = m.generate_model(dicts, rpk, 'com.esri.pyprt.PyEncoder', encoder_options)
+        self.assertEqual(len(models), 3)
+        for model, expected_model in zip(models, expected):
+            self.assertDictEqual(model.get_attributes(), expected_model.get_attributes())
+
+        with self.assertRaises(ValueError):
+            m.generate_model({'maxBuildingHeight': [35.0, 20.0]}, rpk, 'com.esri.pyprt.PyEncoder', encoder_options)
+
+        # integer columns are stored as int32, larger values must not be truncated
+        with self.assertRaises(ValueError):
+            m.generate_model({'seed': np.array([1, 2, 2 ** 40], dtype=np.int64)}, rpk, 'com.esri.pyprt.PyEncoder',
+                             encoder_options)